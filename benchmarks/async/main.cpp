@@ -0,0 +1,252 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// compares `async_dispatcher` against a `std::function<void()>` task queue guarded by
+// a mutex and a condition variable, both with three workers, for a mixed stream of
+// three event types posted by 1 to 32 producer threads.
+// the second sweep posts a skewed mix (14 of 16 events are orders) by 4 producers to
+// 1 to 8 workers, where the ordered dispatcher serves the orders by a single worker
+// and the shared one spreads them over all the workers.
+// "async" reports the wall time per event, "async-latency" the percentiles of the time
+// from the post to the call, in nanoseconds.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <overloaded.hpp>
+#include <overloaded/async.hpp>
+#include <benchmark.hpp>
+
+/***************************************************************************/
+
+inline std::int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+struct order   { std::int64_t posted; std::uint32_t seq; std::uint32_t qty; };
+struct cancel  { std::int64_t posted; std::uint32_t seq; };
+struct quote   { std::int64_t posted; std::uint32_t seq; double bid, ask; };
+
+// every event has its own element, so the handlers running on the different
+// workers never write the same memory
+template<typename Event>
+void record(std::vector<std::int64_t> &latencies, const Event &e) {
+    latencies[e.seq] = now_ns() - e.posted;
+}
+
+struct on_order {
+    std::vector<std::int64_t> *latencies;
+    void operator()(const order &e) const { record(*latencies, e); }
+};
+struct on_cancel {
+    std::vector<std::int64_t> *latencies;
+    void operator()(const cancel &e) const { record(*latencies, e); }
+};
+struct on_quote {
+    std::vector<std::int64_t> *latencies;
+    void operator()(const quote &e) const { record(*latencies, e); }
+};
+
+/***************************************************************************/
+
+struct function_queue {
+    explicit function_queue(std::size_t workers) {
+        for ( std::size_t i = 0; i < workers; ++i ) {
+            threads.emplace_back([this] { work(); });
+        }
+    }
+
+    void post(std::function<void()> f) {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            tasks.push_back(std::move(f));
+        }
+        cv.notify_one();
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            stopping = true;
+        }
+        cv.notify_all();
+        for ( auto &t: threads ) {
+            t.join();
+        }
+    }
+
+private:
+    void work() {
+        for ( ;; ) {
+            std::function<void()> f;
+            {
+                std::unique_lock<std::mutex> lock{mutex};
+                cv.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if ( tasks.empty() ) {
+                    return;
+                }
+                f = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            f();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::function<void()>> tasks;
+    bool stopping = false;
+    std::vector<std::thread> threads;
+};
+
+/***************************************************************************/
+
+enum: std::uint32_t { events = 1u << 17, workers = 3, skewed_producers = 4 };
+
+// runs `producers` threads posting `events` events in total through `post(seq)`,
+// and `finish()` once they are done. reports the time per event and the latencies.
+template<typename Post, typename Finish>
+void run(const char *name, std::size_t producers, std::vector<std::int64_t> &latencies, Post post, Finish finish) {
+    std::uint32_t per_producer = events / producers;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for ( std::size_t p = 0; p < producers; ++p ) {
+        threads.emplace_back([&post, p, per_producer] {
+            std::uint32_t first = static_cast<std::uint32_t>(p) * per_producer;
+            for ( std::uint32_t seq = first; seq < first + per_producer; ++seq ) {
+                post(seq);
+            }
+        });
+    }
+    for ( auto &t: threads ) {
+        t.join();
+    }
+    finish();
+    auto stop = std::chrono::steady_clock::now();
+
+    std::size_t total = per_producer * producers;
+    char case_name[96];
+
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count() / total;
+    std::snprintf(case_name, sizeof(case_name), "%s, %zu producers", name, producers);
+    bench::report("async", case_name, ns);
+
+    std::sort(latencies.begin(), latencies.begin() + total);
+    const double percentiles[] = {50.0, 99.0, 99.9};
+    for ( double pc: percentiles ) {
+        std::size_t idx = static_cast<std::size_t>(pc / 100.0 * (total - 1));
+        std::snprintf(case_name, sizeof(case_name), "%s, %zu producers, p%g", name, producers, pc);
+        bench::report("async-latency", case_name, static_cast<double>(latencies[idx]));
+    }
+}
+
+// the event type is chosen by the sequence number
+template<typename Post>
+void post_event(Post &post, std::uint32_t seq) {
+    switch ( seq % 3 ) {
+        case 0: post(order{now_ns(), seq, seq}); break;
+        case 1: post(cancel{now_ns(), seq}); break;
+        case 2: post(quote{now_ns(), seq, 1.0, 1.5}); break;
+    }
+}
+
+// mostly orders
+template<typename Post>
+void post_skewed_event(Post &post, std::uint32_t seq) {
+    switch ( seq % 16 ) {
+        case 0: post(cancel{now_ns(), seq}); break;
+        case 1: post(quote{now_ns(), seq, 1.0, 1.5}); break;
+        default: post(order{now_ns(), seq, seq}); break;
+    }
+}
+
+/***************************************************************************/
+
+int main() {
+    std::vector<std::int64_t> latencies(events);
+    auto o = overloaded::make(
+         on_order{&latencies}
+        ,on_cancel{&latencies}
+        ,on_quote{&latencies}
+    );
+
+    for ( std::size_t producers: {1, 2, 4, 8, 16, 32} ) {
+        {
+            function_queue queue{workers};
+            auto post = [&queue, &o](const auto &e) { queue.post([&o, e] { o(e); }); };
+            run("std::function queue", producers, latencies, [&post](std::uint32_t seq) {
+                post_event(post, seq);
+            }, [&queue] { queue.stop(); });
+        }
+        {
+            overloaded::async_dispatcher<decltype(o)> dispatcher{o, workers};
+            auto post = [&dispatcher](const auto &e) { dispatcher.post(e); };
+            run("async_dispatcher", producers, latencies, [&post](std::uint32_t seq) {
+                post_event(post, seq);
+            }, [&dispatcher] { dispatcher.stop(); });
+        }
+    }
+
+    char name[64];
+    for ( std::size_t n: {1, 2, 3, 4, 8} ) {
+        {
+            function_queue queue{n};
+            auto post = [&queue, &o](const auto &e) { queue.post([&o, e] { o(e); }); };
+            std::snprintf(name, sizeof(name), "std::function queue, skewed, %zu workers", n);
+            run(name, skewed_producers, latencies, [&post](std::uint32_t seq) {
+                post_skewed_event(post, seq);
+            }, [&queue] { queue.stop(); });
+        }
+        for ( auto mode: {overloaded::async_mode::ordered, overloaded::async_mode::shared} ) {
+            overloaded::async_dispatcher<decltype(o)> dispatcher{o, n, mode};
+            auto post = [&dispatcher](const auto &e) { dispatcher.post(e); };
+            std::snprintf(
+                 name
+                ,sizeof(name)
+                ,"async_dispatcher %s, skewed, %zu workers"
+                ,mode == overloaded::async_mode::shared ? "shared" : "ordered"
+                ,n
+            );
+            run(name, skewed_producers, latencies, [&post](std::uint32_t seq) {
+                post_skewed_event(post, seq);
+            }, [&dispatcher] { dispatcher.stop(); });
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/***************************************************************************/
@@ -0,0 +1,109 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// compares the delivery of an event to four subscribers through `broadcast()`
+// against the subscriber list of `std::vector<std::function<void(const event &)>>`.
+// the `ns_per_op` is per event: all the four calls.
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <overloaded.hpp>
+#include <benchmark.hpp>
+
+/***************************************************************************/
+
+struct event {
+    std::uint64_t id;
+    std::uint32_t size;
+};
+
+struct sink {
+    std::uint64_t acc = 0;
+};
+
+struct count_events {
+    sink *s;
+    void operator()(const event &) const { s->acc += 1; }
+};
+
+struct sum_ids {
+    sink *s;
+    void operator()(const event &e) const { s->acc += e.id; }
+};
+
+struct sum_sizes {
+    sink *s;
+    void operator()(const event &e) const { s->acc += e.size; }
+};
+
+struct mix {
+    sink *s;
+    void operator()(const event &e) const { s->acc ^= e.id * 31 + e.size; }
+};
+
+/***************************************************************************/
+
+enum { batch = 4096, batches = 1024 };
+
+int main() {
+    sink s;
+
+    {
+        std::vector<std::function<void(const event &)>> subscribers;
+        subscribers.emplace_back(count_events{&s});
+        subscribers.emplace_back(sum_ids{&s});
+        subscribers.emplace_back(sum_sizes{&s});
+        subscribers.emplace_back(mix{&s});
+
+        auto r = bench::measure(batches, [&](std::size_t n) {
+            for ( std::size_t i = 0; i < batch; ++i ) {
+                const event e{n + i, static_cast<std::uint32_t>(i)};
+                for ( const auto &f: subscribers ) {
+                    f(e);
+                }
+            }
+            bench::do_not_optimize(s.acc);
+        }, batch);
+        bench::report("broadcast", "std::vector<std::function<void(const event &)>>", r);
+    }
+    {
+        auto o = overloaded::make_multi(count_events{&s}, sum_ids{&s}, sum_sizes{&s}, mix{&s});
+
+        auto r = bench::measure(batches, [&](std::size_t n) {
+            for ( std::size_t i = 0; i < batch; ++i ) {
+                const event e{n + i, static_cast<std::uint32_t>(i)};
+                o.broadcast(e);
+            }
+            bench::do_not_optimize(s.acc);
+        }, batch);
+        bench::report("broadcast", "make_multi().broadcast()", r);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/***************************************************************************/
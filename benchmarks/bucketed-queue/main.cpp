@@ -0,0 +1,119 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// compares the throughput of `bucketed_queue` against the type-erased queue of
+// `std::vector<std::function<void()>>`, for a mixed stream of three signatures.
+// the `ns_per_op` is per event: one push and one call.
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <overloaded.hpp>
+#include <overloaded/bucketed_queue.hpp>
+#include <benchmark.hpp>
+
+/***************************************************************************/
+
+struct sink {
+    std::uint64_t acc = 0;
+};
+
+struct on_int {
+    sink *s;
+    void operator()(int v) const { s->acc += static_cast<std::uint64_t>(v); }
+};
+
+struct on_pair {
+    sink *s;
+    void operator()(int v, double d) const { s->acc += static_cast<std::uint64_t>(v + d); }
+};
+
+// the arguments are bigger than the `std::function` small-buffer
+struct on_triple {
+    sink *s;
+    void operator()(std::uint64_t a, std::uint64_t b, std::uint64_t c) const { s->acc += a ^ b ^ c; }
+};
+
+/***************************************************************************/
+
+enum { batch = 4096, batches = 256 };
+
+int main() {
+    sink s;
+    auto o = overloaded::make(on_int{&s}, on_pair{&s}, on_triple{&s});
+
+    {
+        std::vector<std::function<void()>> queue;
+        queue.reserve(batch);
+
+        auto r = bench::measure(batches, [&](std::size_t n) {
+            for ( std::size_t i = 0; i < batch; ++i ) {
+                int v = static_cast<int>(n + i);
+                switch ( i % 3 ) {
+                    case 0: queue.emplace_back([&o, v] { o(v); }); break;
+                    case 1: queue.emplace_back([&o, v] { o(v, 0.5); }); break;
+                    case 2: {
+                        std::uint64_t a = v, b = v + 1, c = v + 2;
+                        queue.emplace_back([&o, a, b, c] { o(a, b, c); });
+                        break;
+                    }
+                }
+            }
+            for ( auto &f: queue ) {
+                f();
+            }
+            queue.clear();
+            bench::do_not_optimize(s.acc);
+        }, batch);
+        bench::report("queue", "std::vector<std::function<void()>>", r);
+    }
+    {
+        overloaded::bucketed_queue<decltype(o)> queue;
+        queue.reserve(batch);
+
+        auto r = bench::measure(batches, [&](std::size_t n) {
+            for ( std::size_t i = 0; i < batch; ++i ) {
+                int v = static_cast<int>(n + i);
+                switch ( i % 3 ) {
+                    case 0: queue.push(v); break;
+                    case 1: queue.push(v, 0.5); break;
+                    case 2: {
+                        std::uint64_t a = v, b = v + 1, c = v + 2;
+                        queue.push(a, b, c);
+                        break;
+                    }
+                }
+            }
+            queue.drain(o);
+            bench::do_not_optimize(s.acc);
+        }, batch);
+        bench::report("queue", "bucketed_queue", r);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/***************************************************************************/
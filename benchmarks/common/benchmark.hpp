@@ -0,0 +1,191 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __OVERLOADED_BENCHMARK_HPP
+#define __OVERLOADED_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#if defined(__linux__)
+#   include <linux/perf_event.h>
+#   include <sys/ioctl.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#endif // __linux__
+
+/***************************************************************************/
+// tiny helpers shared by the benchmarks.
+// every measurement is printed as a single JSON object per line.
+
+namespace bench {
+
+template<typename T>
+inline void do_not_optimize(const T &v) {
+    asm volatile("" : : "r,m"(v) : "memory");
+}
+
+inline void clobber_memory() {
+    asm volatile("" : : : "memory");
+}
+
+// calls `f(i)` for `iterations` times, repeats `runs` times,
+// and returns the best observed time per iteration in nanoseconds.
+template<typename F>
+double measure_ns(std::size_t iterations, F &&f, std::size_t runs = 5) {
+    double best = 0;
+    for ( std::size_t run = 0; run < runs; ++run ) {
+        auto start = std::chrono::steady_clock::now();
+        for ( std::size_t i = 0; i < iterations; ++i ) {
+            f(i);
+        }
+        auto stop = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(stop - start).count() / iterations;
+        best = (run == 0) ? ns : std::min(best, ns);
+    }
+
+    return best;
+}
+
+// counts the user-space retired instructions of the calling thread.
+// not available outside of linux or when `perf_event_paranoid` forbids it.
+struct instruction_counter {
+    instruction_counter()
+        :fd{-1}
+    {
+#if defined(__linux__)
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(::syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif // __linux__
+    }
+    ~instruction_counter() {
+#if defined(__linux__)
+        if ( fd != -1 ) { ::close(fd); }
+#endif // __linux__
+    }
+
+    instruction_counter(const instruction_counter &) = delete;
+    instruction_counter& operator= (const instruction_counter &) = delete;
+
+    bool available() const { return fd != -1; }
+
+    void start() {
+#if defined(__linux__)
+        if ( fd != -1 ) {
+            ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif // __linux__
+    }
+    std::uint64_t stop() {
+        std::uint64_t count = 0;
+#if defined(__linux__)
+        if ( fd != -1 ) {
+            ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            if ( ::read(fd, &count, sizeof(count)) != sizeof(count) ) {
+                count = 0;
+            }
+        }
+#endif // __linux__
+        return count;
+    }
+
+private:
+    int fd;
+};
+
+struct result {
+    double ns_per_op;
+    double instructions_per_op; // negative when not available
+};
+
+// like `measure_ns()` but also counts the instructions of the best run.
+// `ops_per_iteration` is used to report the cost of a single operation.
+template<typename F>
+result measure(std::size_t iterations, F &&f, std::size_t ops_per_iteration = 1, std::size_t runs = 5) {
+    instruction_counter counter;
+    result best{0, -1};
+    for ( std::size_t run = 0; run < runs; ++run ) {
+        counter.start();
+        auto start = std::chrono::steady_clock::now();
+        for ( std::size_t i = 0; i < iterations; ++i ) {
+            f(i);
+        }
+        auto stop = std::chrono::steady_clock::now();
+        std::uint64_t instructions = counter.stop();
+
+        double ops = static_cast<double>(iterations) * ops_per_iteration;
+        double ns = std::chrono::duration<double, std::nano>(stop - start).count() / ops;
+        if ( run == 0 || ns < best.ns_per_op ) {
+            best.ns_per_op = ns;
+            best.instructions_per_op = counter.available() ? instructions / ops : -1;
+        }
+    }
+
+    return best;
+}
+
+inline void report(const char *suite, const char *name, const result &r) {
+    if ( r.instructions_per_op < 0 ) {
+        std::printf(
+             "{\"suite\":\"%s\",\"case\":\"%s\",\"ns_per_op\":%.3f,\"instructions_per_op\":null}\n"
+            ,suite
+            ,name
+            ,r.ns_per_op
+        );
+    } else {
+        std::printf(
+             "{\"suite\":\"%s\",\"case\":\"%s\",\"ns_per_op\":%.3f,\"instructions_per_op\":%.2f}\n"
+            ,suite
+            ,name
+            ,r.ns_per_op
+            ,r.instructions_per_op
+        );
+    }
+}
+
+inline void report(const char *suite, const char *name, double ns_per_op) {
+    std::printf(
+         "{\"suite\":\"%s\",\"case\":\"%s\",\"ns_per_op\":%.3f}\n"
+        ,suite
+        ,name
+        ,ns_per_op
+    );
+}
+
+} // ns bench
+
+/***************************************************************************/
+
+#endif // __OVERLOADED_BENCHMARK_HPP
@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+
+# The MIT License (MIT)
+#
+# Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+#
+# This file is the part of the project 'Overloaded':
+#       github.com/nixman/overloaded
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy of
+# this software and associated documentation files (the "Software"), to deal in
+# the Software without restriction, including without limitation the rights to
+# use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+# the Software, and to permit persons to whom the Software is furnished to do so,
+# subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+# FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+# COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+# IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+# CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+# generates translation units with overload sets of growing size, compiles
+# each one and reports the compile wall time, the peak compiler memory and
+# the object size as JSON.
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+DEFAULT_INCLUDE = os.path.normpath(os.path.join(HERE, '..', '..', 'include'))
+
+def generate(kind, n):
+    src = ['#include <overloaded.hpp>', '']
+    for i in range(n):
+        src.append('struct tag_{0} {{}};'.format(i))
+        if kind == 'function-pointers':
+            src.append('int h_{0}(tag_{0}, int v) {{ return v + {0}; }}'.format(i))
+    src.append('')
+
+    if kind == 'function-pointers':
+        funcs = ['&h_{0}'.format(i) for i in range(n)]
+        sigs = ['decltype(&h_{0})'.format(i) for i in range(n)]
+    else:
+        funcs = ['[](tag_{0}, int v) {{ return v + {0}; }}'.format(i) for i in range(n)]
+        sigs = ['int(tag_{0}, int)'.format(i) for i in range(n)]
+
+    src.append('using declared_type = overloaded::make_overloaded<')
+    src.append('     ' + '\n    ,'.join(sigs))
+    src.append('>::type;')
+    src.append('')
+    src.append('int run(int v) {')
+    src.append('    auto o = overloaded::make(')
+    src.append('         ' + '\n        ,'.join(funcs))
+    src.append('    );')
+    src.append('    declared_type d = o;')
+    src.append('    int r = 0;')
+    for i in range(n):
+        src.append('    r += o(tag_{0}{{}}, v);'.format(i))
+        src.append('    r += d.invoke(tag_{0}{{}}, v);'.format(i))
+    src.append('    return r;')
+    src.append('}')
+    src.append('')
+
+    return '\n'.join(src)
+
+def compile_one(args, path, obj):
+    cmd = [args.compiler, '-std=' + args.std, '-I' + args.include, '-c', path, '-o', obj]
+    cmd += args.flags.split()
+
+    # the diagnostics go to a file: a pipe read after the exit would block
+    # the compiler once they exceed the pipe buffer
+    with tempfile.TemporaryFile() as diagnostics:
+        start = time.monotonic()
+        proc = subprocess.Popen(cmd, stderr=diagnostics)
+        _, status, usage = os.wait4(proc.pid, 0)
+        wall = time.monotonic() - start
+        proc.returncode = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -1
+        if proc.returncode != 0:
+            diagnostics.seek(0)
+            sys.stderr.write(diagnostics.read().decode(errors='replace'))
+            raise SystemExit('compilation failed: ' + ' '.join(cmd))
+
+    # ru_maxrss is in kilobytes on Linux
+    return wall, usage.ru_maxrss * 1024, os.path.getsize(obj)
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--compiler', default=os.environ.get('CXX', 'c++'))
+    parser.add_argument('--std', default='c++11')
+    parser.add_argument('--flags', default='-O2')
+    parser.add_argument('--include', default=DEFAULT_INCLUDE)
+    parser.add_argument('--sizes', default='8,32,128,256')
+    parser.add_argument('--kinds', default='function-pointers,lambdas')
+    parser.add_argument('--repeat', type=int, default=3)
+    parser.add_argument('--output', default='-')
+    args = parser.parse_args()
+
+    results = []
+    with tempfile.TemporaryDirectory() as tmp:
+        for kind in args.kinds.split(','):
+            for n in [int(v) for v in args.sizes.split(',')]:
+                path = os.path.join(tmp, '{0}-{1}.cpp'.format(kind, n))
+                obj = path[:-4] + '.o'
+                with open(path, 'w') as f:
+                    f.write(generate(kind, n))
+
+                # the best wall time and the worst memory of the repeats
+                runs = [compile_one(args, path, obj) for _ in range(args.repeat)]
+                results.append({
+                     'kind': kind
+                    ,'signatures': n
+                    ,'compile_seconds': round(min(r[0] for r in runs), 4)
+                    ,'peak_memory_bytes': max(r[1] for r in runs)
+                    ,'object_bytes': runs[-1][2]
+                })
+                sys.stderr.write('{0} x{1}: {2}\n'.format(kind, n, results[-1]))
+
+    report = {
+         'compiler': args.compiler
+        ,'std': args.std
+        ,'flags': args.flags
+        ,'results': results
+    }
+    text = json.dumps(report, indent=4) + '\n'
+    if args.output == '-':
+        sys.stdout.write(text)
+    else:
+        with open(args.output, 'w') as f:
+            f.write(text)
+
+if __name__ == '__main__':
+    main()
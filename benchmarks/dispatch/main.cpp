@@ -0,0 +1,190 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// measures ns/call and instructions/call of `overloaded_function::operator()`
+// against a direct call, a `std::function` per signature, the virtual dispatch
+// and `std::visit` over a `std::variant`, for the every kind of callable.
+// every line of the output is a JSON object, the `suite` field is the callable
+// kind and the `case` field is the dispatch method.
+
+#include <functional>
+#include <variant>
+
+#include <overloaded.hpp>
+#include <benchmark.hpp>
+
+/***************************************************************************/
+
+struct tag_a{};
+struct tag_b{};
+
+int func_a(tag_a, int v) { return v + 1; }
+int func_b(tag_b, int v) { return v * 3; }
+
+// the same as the `callable` from the tests: movable only
+struct functor_a {
+    functor_a() = default;
+    functor_a(const functor_a &) = delete;
+    functor_a& operator= (const functor_a &) = delete;
+    functor_a(functor_a &&) = default;
+    functor_a& operator= (functor_a &&) = default;
+
+    int operator()(tag_a, int v) const { return v + 1; }
+};
+
+struct functor_b {
+    functor_b() = default;
+    functor_b(const functor_b &) = delete;
+    functor_b& operator= (const functor_b &) = delete;
+    functor_b(functor_b &&) = default;
+    functor_b& operator= (functor_b &&) = default;
+
+    int operator()(tag_b, int v) const { return v * 3; }
+};
+
+/***************************************************************************/
+
+struct virtual_base {
+    virtual ~virtual_base() = default;
+    virtual int operator()(tag_a, int v) const = 0;
+    virtual int operator()(tag_b, int v) const = 0;
+};
+
+template<typename A, typename B>
+struct virtual_impl final: virtual_base {
+    virtual_impl(A &&a, B &&b)
+        :a{std::move(a)}
+        ,b{std::move(b)}
+    {}
+
+    int operator()(tag_a t, int v) const override { return a(t, v); }
+    int operator()(tag_b t, int v) const override { return b(t, v); }
+
+    A a;
+    B b;
+};
+
+template<typename A, typename B>
+struct visitor {
+    const A &a;
+    const B &b;
+    int v;
+
+    int operator()(tag_a t) const { return a(t, v); }
+    int operator()(tag_b t) const { return b(t, v); }
+};
+
+/***************************************************************************/
+
+enum { iterations = 10000000 };
+
+template<typename MakeA, typename MakeB>
+void run(const char *kind, MakeA make_a, MakeB make_b) {
+    { // direct
+        auto a = make_a();
+        auto b = make_b();
+        auto r = bench::measure(iterations, [&](std::size_t i) {
+            int v = static_cast<int>(i);
+            bench::do_not_optimize(a(tag_a{}, v));
+            bench::do_not_optimize(b(tag_b{}, v));
+        }, 2);
+        bench::report(kind, "direct", r);
+    }
+    { // overloaded
+        auto o = overloaded::make(make_a(), make_b());
+        bench::do_not_optimize(o);
+        auto r = bench::measure(iterations, [&](std::size_t i) {
+            int v = static_cast<int>(i);
+            bench::do_not_optimize(o(tag_a{}, v));
+            bench::do_not_optimize(o(tag_b{}, v));
+        }, 2);
+        bench::report(kind, "overloaded", r);
+    }
+    { // std::function per signature
+        auto a = make_a();
+        auto b = make_b();
+        std::function<int(tag_a, int)> fa = std::cref(a);
+        std::function<int(tag_b, int)> fb = std::cref(b);
+        bench::do_not_optimize(fa);
+        bench::do_not_optimize(fb);
+        auto r = bench::measure(iterations, [&](std::size_t i) {
+            int v = static_cast<int>(i);
+            bench::do_not_optimize(fa(tag_a{}, v));
+            bench::do_not_optimize(fb(tag_b{}, v));
+        }, 2);
+        bench::report(kind, "std::function", r);
+    }
+    { // virtual
+        virtual_impl<decltype(make_a()), decltype(make_b())> impl{make_a(), make_b()};
+        const virtual_base *base = &impl;
+        bench::do_not_optimize(base);
+        auto r = bench::measure(iterations, [&](std::size_t i) {
+            int v = static_cast<int>(i);
+            bench::do_not_optimize((*base)(tag_a{}, v));
+            bench::do_not_optimize((*base)(tag_b{}, v));
+        }, 2);
+        bench::report(kind, "virtual", r);
+    }
+    { // std::visit
+        auto a = make_a();
+        auto b = make_b();
+        std::variant<tag_a, tag_b> events[2] = {tag_a{}, tag_b{}};
+        bench::do_not_optimize(events);
+        auto r = bench::measure(iterations, [&](std::size_t i) {
+            visitor<decltype(a), decltype(b)> vis{a, b, static_cast<int>(i)};
+            bench::do_not_optimize(std::visit(vis, events[0]));
+            bench::do_not_optimize(std::visit(vis, events[1]));
+        }, 2);
+        bench::report(kind, "std::visit", r);
+    }
+}
+
+/***************************************************************************/
+
+int main() {
+    int bias = 1;
+    bench::do_not_optimize(bias);
+
+    run("function-pointers"
+        ,[] { return &func_a; }
+        ,[] { return &func_b; }
+    );
+    run("stateless-lambdas"
+        ,[] { return [](tag_a, int v) { return v + 1; }; }
+        ,[] { return [](tag_b, int v) { return v * 3; }; }
+    );
+    run("capturing-lambdas"
+        ,[&bias] { return [&bias](tag_a, int v) { return v + bias; }; }
+        ,[&bias] { return [&bias](tag_b, int v) { return v * 3 + bias; }; }
+    );
+    run("non-copyable-functors"
+        ,[] { return functor_a{}; }
+        ,[] { return functor_b{}; }
+    );
+
+    return EXIT_SUCCESS;
+}
+
+/***************************************************************************/
@@ -0,0 +1,174 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// compares the selection of the collision handler on the dynamic types of two shapes:
+// the `dynamic_cast` chains, the classic double virtual dispatch (visitor), and
+// `overloaded_function::dispatch()`. the pairs of 4 shape classes are shuffled,
+// the `ns_per_op` is per pair.
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <overloaded.hpp>
+#include <benchmark.hpp>
+
+/***************************************************************************/
+
+struct circle;
+struct box;
+struct capsule;
+struct polygon;
+
+using shapes = overloaded::type_list<circle, box, capsule, polygon>;
+
+struct shape {
+    explicit shape(std::size_t id)
+        :id{id}
+    {}
+    virtual ~shape() {}
+
+    std::size_t dispatch_id() const { return id; }
+
+    // the visitor's double dispatch: the first call selects `this`, the second one `other`
+    virtual std::uint64_t collide(const shape &other) const = 0;
+    virtual std::uint64_t collide_with(const circle &) const = 0;
+    virtual std::uint64_t collide_with(const box &) const = 0;
+    virtual std::uint64_t collide_with(const capsule &) const = 0;
+    virtual std::uint64_t collide_with(const polygon &) const = 0;
+
+    const std::size_t id;
+};
+
+// the handler of the pair of the classes
+template<typename L, typename R>
+std::uint64_t collide(const L &, const R &) {
+    return overloaded::dispatch_id_of<L, shapes>::value * 4 + overloaded::dispatch_id_of<R, shapes>::value;
+}
+
+template<typename T>
+struct shape_impl: shape {
+    shape_impl(): shape(overloaded::dispatch_id_of<T, shapes>::value) {}
+
+    std::uint64_t collide(const shape &other) const override {
+        return other.collide_with(static_cast<const T &>(*this));
+    }
+    std::uint64_t collide_with(const circle &l) const override;
+    std::uint64_t collide_with(const box &l) const override;
+    std::uint64_t collide_with(const capsule &l) const override;
+    std::uint64_t collide_with(const polygon &l) const override;
+};
+
+struct circle: shape_impl<circle> {};
+struct box: shape_impl<box> {};
+struct capsule: shape_impl<capsule> {};
+struct polygon: shape_impl<polygon> {};
+
+template<typename T>
+std::uint64_t shape_impl<T>::collide_with(const circle &l) const { return ::collide(l, static_cast<const T &>(*this)); }
+template<typename T>
+std::uint64_t shape_impl<T>::collide_with(const box &l) const { return ::collide(l, static_cast<const T &>(*this)); }
+template<typename T>
+std::uint64_t shape_impl<T>::collide_with(const capsule &l) const { return ::collide(l, static_cast<const T &>(*this)); }
+template<typename T>
+std::uint64_t shape_impl<T>::collide_with(const polygon &l) const { return ::collide(l, static_cast<const T &>(*this)); }
+
+template<typename L>
+std::uint64_t collide_cast(const L &l, const shape &r) {
+    if ( auto p = dynamic_cast<const circle *>(&r) ) { return collide(l, *p); }
+    if ( auto p = dynamic_cast<const box *>(&r) ) { return collide(l, *p); }
+    if ( auto p = dynamic_cast<const capsule *>(&r) ) { return collide(l, *p); }
+    return collide(l, dynamic_cast<const polygon &>(r));
+}
+
+std::uint64_t collide_cast(const shape &l, const shape &r) {
+    if ( auto p = dynamic_cast<const circle *>(&l) ) { return collide_cast(*p, r); }
+    if ( auto p = dynamic_cast<const box *>(&l) ) { return collide_cast(*p, r); }
+    if ( auto p = dynamic_cast<const capsule *>(&l) ) { return collide_cast(*p, r); }
+    return collide_cast(dynamic_cast<const polygon &>(l), r);
+}
+
+/***************************************************************************/
+
+enum { pairs = 4096, batches = 1024 };
+
+template<typename F>
+void run(const char *name, const std::vector<std::unique_ptr<shape>> &objs, F &&f) {
+    std::uint64_t acc = 0;
+    auto r = bench::measure(batches, [&](std::size_t) {
+        for ( std::size_t i = 0; i + 1 < objs.size(); i += 2 ) {
+            acc += f(*objs[i], *objs[i+1]);
+        }
+        bench::do_not_optimize(acc);
+    }, pairs);
+    bench::report("double-dispatch", name, r);
+}
+
+int main() {
+    std::vector<std::unique_ptr<shape>> objs;
+    std::mt19937 gen{42};
+    for ( std::size_t i = 0; i < pairs * 2; ++i ) {
+        switch ( gen() % 4 ) {
+            case 0: objs.emplace_back(new circle); break;
+            case 1: objs.emplace_back(new box); break;
+            case 2: objs.emplace_back(new capsule); break;
+            default: objs.emplace_back(new polygon); break;
+        }
+    }
+
+    run("dynamic_cast chains", objs, [](const shape &l, const shape &r) {
+        return collide_cast(l, r);
+    });
+    run("virtual double dispatch", objs, [](const shape &l, const shape &r) {
+        return l.collide(r);
+    });
+
+    auto o = overloaded::make(
+         [](const circle &l, const circle &r) { return collide(l, r); }
+        ,[](const circle &l, const box &r) { return collide(l, r); }
+        ,[](const circle &l, const capsule &r) { return collide(l, r); }
+        ,[](const circle &l, const polygon &r) { return collide(l, r); }
+        ,[](const box &l, const circle &r) { return collide(l, r); }
+        ,[](const box &l, const box &r) { return collide(l, r); }
+        ,[](const box &l, const capsule &r) { return collide(l, r); }
+        ,[](const box &l, const polygon &r) { return collide(l, r); }
+        ,[](const capsule &l, const circle &r) { return collide(l, r); }
+        ,[](const capsule &l, const box &r) { return collide(l, r); }
+        ,[](const capsule &l, const capsule &r) { return collide(l, r); }
+        ,[](const capsule &l, const polygon &r) { return collide(l, r); }
+        ,[](const polygon &l, const circle &r) { return collide(l, r); }
+        ,[](const polygon &l, const box &r) { return collide(l, r); }
+        ,[](const polygon &l, const capsule &r) { return collide(l, r); }
+        ,[](const polygon &l, const polygon &r) { return collide(l, r); }
+    );
+    run("overloaded_function::dispatch()", objs, [&o](const shape &l, const shape &r) {
+        return o.dispatch<shapes>(l, r);
+    });
+
+    return EXIT_SUCCESS;
+}
+
+/***************************************************************************/
@@ -0,0 +1,135 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// compares the calls through `dynamic_overloaded` with the 16 handlers registered at
+// run time against the `std::unordered_map<std::type_index, std::function<...>>` registry,
+// and against the same handlers in the compile-time `make()` holder for the reference.
+// every iteration calls all the 16 handlers, the `ns_per_op` is per call.
+
+#include <cstdint>
+#include <functional>
+#include <typeindex>
+#include <unordered_map>
+
+#include <overloaded.hpp>
+#include <overloaded/dynamic.hpp>
+#include <benchmark.hpp>
+
+/***************************************************************************/
+
+template<int N>
+struct msg {
+    std::uint64_t v;
+};
+
+template<int N>
+struct handler {
+    std::uint64_t operator()(const msg<N> &m) const { return m.v * (N + 1); }
+};
+
+enum { kinds = 16 };
+
+template<int... Ns>
+struct kind_list {};
+
+using all_kinds = kind_list<0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15>;
+
+template<int... Ns>
+void register_handlers(overloaded::dynamic_overloaded &d, kind_list<Ns...>) {
+    using swallow = int[];
+    (void)swallow{0, (d.add(handler<Ns>{}), 0)...};
+}
+
+using registry_type = std::unordered_map<
+     std::type_index
+    ,std::function<std::uint64_t(const void *)>
+>;
+
+template<int... Ns>
+void register_handlers(registry_type &r, kind_list<Ns...>) {
+    using swallow = int[];
+    (void)swallow{0, (r.emplace(
+         std::type_index(typeid(msg<Ns>))
+        ,[](const void *m) { return handler<Ns>{}(*static_cast<const msg<Ns> *>(m)); }
+    ), 0)...};
+}
+
+template<typename F, int... Ns>
+std::uint64_t call_all(F &f, std::uint64_t v, kind_list<Ns...>) {
+    std::uint64_t acc = 0;
+    using swallow = int[];
+    (void)swallow{0, (acc += f(msg<Ns>{v + Ns}), 0)...};
+
+    return acc;
+}
+
+/***************************************************************************/
+
+enum { batch = 1024, batches = 1024 };
+
+template<typename F>
+void run(const char *name, F &&f) {
+    std::uint64_t acc = 0;
+    auto r = bench::measure(batches, [&](std::size_t n) {
+        for ( std::size_t i = 0; i < batch; ++i ) {
+            acc += call_all(f, n + i, all_kinds{});
+        }
+        bench::do_not_optimize(acc);
+    }, batch * kinds);
+    bench::report("dynamic", name, r);
+}
+
+int main() {
+    {
+        registry_type registry;
+        register_handlers(registry, all_kinds{});
+
+        auto f = [&registry](const auto &m) {
+            return registry.find(std::type_index(typeid(m)))->second(&m);
+        };
+        run("std::unordered_map<std::type_index, std::function>", f);
+    }
+    {
+        overloaded::dynamic_overloaded d;
+        register_handlers(d, all_kinds{});
+        d.seal();
+
+        auto f = [&d](const auto &m) { return d.call<std::uint64_t>(m); };
+        run("dynamic_overloaded", f);
+    }
+    {
+        auto o = overloaded::make(
+             handler<0>{}, handler<1>{}, handler<2>{}, handler<3>{}
+            ,handler<4>{}, handler<5>{}, handler<6>{}, handler<7>{}
+            ,handler<8>{}, handler<9>{}, handler<10>{}, handler<11>{}
+            ,handler<12>{}, handler<13>{}, handler<14>{}, handler<15>{}
+        );
+        run("make() (compile time)", o);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/***************************************************************************/
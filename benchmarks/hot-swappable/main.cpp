@@ -0,0 +1,138 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// compares the read throughput of a `hot_swappable` callable-elem against
+// a `std::function` guarded by `std::shared_mutex`, while a writer thread
+// replaces the callable every 50us. the `ns_per_op` is the wall time divided
+// by the total number of calls of all the readers.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include <overloaded.hpp>
+#include <overloaded/hot_swappable.hpp>
+#include <benchmark.hpp>
+
+/***************************************************************************/
+
+struct locked_function {
+    int operator()(int v) const {
+        std::shared_lock<std::shared_mutex> lock{mutex};
+        return f(v);
+    }
+
+    void store(std::function<int(int)> g) {
+        std::unique_lock<std::shared_mutex> lock{mutex};
+        f = std::move(g);
+    }
+
+    mutable std::shared_mutex mutex;
+    std::function<int(int)> f;
+};
+
+/***************************************************************************/
+
+enum { calls_per_reader = 1 << 22 };
+
+// runs `readers` threads calling `call(i)`, and a writer calling `swap(gen)`
+// until all the readers are done. returns the nanoseconds per call.
+template<typename Call, typename Swap>
+double run(std::size_t readers, Call call, Swap swap) {
+    std::atomic<std::size_t> ready{0};
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> threads;
+    for ( std::size_t i = 0; i < readers; ++i ) {
+        threads.emplace_back([&] {
+            ready.fetch_add(1);
+            while ( ready.load() != readers ) {}
+
+            std::uint64_t acc = 0;
+            for ( int n = 0; n < calls_per_reader; ++n ) {
+                acc += static_cast<std::uint64_t>(call(n));
+            }
+            bench::do_not_optimize(acc);
+        });
+    }
+    std::thread writer([&] {
+        for ( int gen = 0; !done.load(); ++gen ) {
+            swap(gen);
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    });
+
+    while ( ready.load() != readers ) {}
+    auto start = std::chrono::steady_clock::now();
+    for ( auto &t: threads ) {
+        t.join();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    done = true;
+    writer.join();
+
+    double calls = static_cast<double>(readers) * calls_per_reader;
+    return std::chrono::duration<double, std::nano>(stop - start).count() / calls;
+}
+
+/***************************************************************************/
+
+int main() {
+    for ( std::size_t readers: {1, 2, 4, 8, 16} ) {
+        char name[64];
+        {
+            locked_function f;
+            f.store([](int v) { return v; });
+
+            double ns = run(readers, [&f](int v) { return f(v); }, [&f](int gen) {
+                f.store([gen](int v) { return v+gen; });
+            });
+            std::snprintf(name, sizeof(name), "std::shared_mutex, %zu readers", readers);
+            bench::report("hot-swappable", name, ns);
+        }
+        {
+            auto o = overloaded::make(
+                overloaded::hot_swappable<int(int)>([](int v) { return v; })
+            );
+            auto &slot = o.get<int(int)>();
+
+            double ns = run(readers, [&o](int v) { return o(v); }, [&slot](int gen) {
+                slot.store([gen](int v) { return v+gen; });
+            });
+            slot.reclaim();
+            std::snprintf(name, sizeof(name), "hot_swappable, %zu readers", readers);
+            bench::report("hot-swappable", name, ns);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/***************************************************************************/
@@ -0,0 +1,98 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// compares the `make_overloaded_inplace` slots against the `std::function` slots
+// for the construction cost and for the call latency.
+
+#include <functional>
+
+#include <overloaded.hpp>
+#include <benchmark.hpp>
+
+/***************************************************************************/
+
+struct tag_add{};
+struct tag_sub{};
+
+using std_function_type = overloaded::make_overloaded<
+     std::function<int(tag_add, int, int)>
+    ,std::function<int(tag_sub, int, int)>
+>::type;
+
+using inplace_type = overloaded::make_overloaded_inplace<
+     32
+    ,int(tag_add, int, int)
+    ,int(tag_sub, int, int)
+>::type;
+
+// the captured state is bigger than the `std::function` small-buffer
+struct state {
+    int bias;
+    int scale;
+    long pad[2];
+};
+
+template<typename Holder>
+Holder construct(const state &s) {
+    return overloaded::make(
+         [s](tag_add, int l, int r) { return (l + r) * s.scale + s.bias; }
+        ,[s](tag_sub, int l, int r) { return (l - r) * s.scale + s.bias; }
+    );
+}
+
+template<typename Holder>
+void run(const char *name) {
+    enum { iterations = 1000000 };
+
+    state s{1, 2, {0, 0}};
+    bench::do_not_optimize(s);
+
+    double ns = bench::measure_ns(iterations, [&s](std::size_t) {
+        Holder h = construct<Holder>(s);
+        bench::do_not_optimize(h);
+    });
+    bench::report("construct", name, ns);
+
+    Holder h = construct<Holder>(s);
+    bench::do_not_optimize(h);
+    int acc = 0;
+    ns = bench::measure_ns(iterations, [&h, &acc](std::size_t i) {
+        acc += h(tag_add{}, static_cast<int>(i), 1);
+        acc += h(tag_sub{}, static_cast<int>(i), 1);
+        bench::do_not_optimize(acc);
+    });
+    bench::report("call", name, ns / 2);
+}
+
+/***************************************************************************/
+
+int main() {
+    run<std_function_type>("std::function");
+    run<inplace_type>("inplace_function");
+
+    return EXIT_SUCCESS;
+}
+
+/***************************************************************************/
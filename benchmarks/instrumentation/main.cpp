@@ -0,0 +1,80 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// measures the cost of the `instrumented` policy against the default `no_policy`,
+// for a cheap callable-elem. the `ns_per_op` is per call.
+
+#include <cstdint>
+
+#include <overloaded.hpp>
+#include <overloaded/instrumentation.hpp>
+#include <benchmark.hpp>
+
+/***************************************************************************/
+
+struct sink {
+    std::uint64_t acc = 0;
+};
+
+struct on_int {
+    sink *s;
+    void operator()(int v) const { s->acc += static_cast<std::uint64_t>(v); }
+};
+
+struct on_double {
+    sink *s;
+    void operator()(double v) const { s->acc += static_cast<std::uint64_t>(v); }
+};
+
+/***************************************************************************/
+
+enum { iterations = 1 << 22 };
+
+int main() {
+    sink s;
+    auto o = overloaded::make(on_int{&s}, on_double{&s});
+
+    {
+        auto r = bench::measure(iterations, [&](std::size_t i) {
+            o(static_cast<int>(i));
+            bench::do_not_optimize(s.acc);
+        });
+        bench::report("instrumentation", "no_policy", r);
+    }
+    {
+        overloaded::call_stats stats{o};
+        auto inst = overloaded::with_policy(o, overloaded::instrumented{&stats});
+
+        auto r = bench::measure(iterations, [&](std::size_t i) {
+            inst(static_cast<int>(i));
+            bench::do_not_optimize(s.acc);
+        });
+        bench::report("instrumentation", "instrumented", r);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/***************************************************************************/
@@ -0,0 +1,113 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// compares `overloaded_function::invoke_by_index()` against the hand-written
+// `switch` over the runtime opcode, for 4, 16 and 64 handlers.
+
+#include <random>
+#include <vector>
+
+#include <overloaded.hpp>
+#include <benchmark.hpp>
+
+/***************************************************************************/
+
+template<std::size_t N>
+struct tag {};
+
+template<std::size_t N>
+int handler(tag<N>, int l, int r) { return l * static_cast<int>(N + 1) + r; }
+
+template<std::size_t... Is>
+auto make_handlers(overloaded::details::index_sequence<Is...>)
+    -> decltype(overloaded::make(&handler<Is>...))
+{
+    return overloaded::make(&handler<Is>...);
+}
+
+#define CASE(n) case (n): return o(tag<(n)>{}, l, r);
+#define CASES4(n) CASE(n) CASE(n+1) CASE(n+2) CASE(n+3)
+#define CASES16(n) CASES4(n) CASES4(n+4) CASES4(n+8) CASES4(n+12)
+#define CASES64(n) CASES16(n) CASES16(n+16) CASES16(n+32) CASES16(n+48)
+
+template<typename O>
+int switch4(const O &o, std::size_t op, int l, int r) {
+    switch ( op ) { CASES4(0) }
+    return 0;
+}
+template<typename O>
+int switch16(const O &o, std::size_t op, int l, int r) {
+    switch ( op ) { CASES16(0) }
+    return 0;
+}
+template<typename O>
+int switch64(const O &o, std::size_t op, int l, int r) {
+    switch ( op ) { CASES64(0) }
+    return 0;
+}
+
+/***************************************************************************/
+
+enum { iterations = 1 << 20 };
+
+template<std::size_t N, typename Switch>
+void run(const char *name, Switch sw) {
+    auto o = make_handlers(overloaded::details::make_index_sequence<N>{});
+    bench::do_not_optimize(o);
+
+    // random opcodes, so the branch predictor can't learn the sequence
+    std::vector<std::size_t> ops(iterations);
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<std::size_t> dist{0, N - 1};
+    for ( auto &op: ops ) {
+        op = dist(gen);
+    }
+
+    auto r = bench::measure(iterations, [&](std::size_t i) {
+        bench::do_not_optimize(sw(o, ops[i], static_cast<int>(i), 1));
+    });
+    bench::report("switch", name, r);
+
+    r = bench::measure(iterations, [&](std::size_t i) {
+        bench::do_not_optimize(o.invoke_by_index(ops[i], static_cast<int>(i), 1));
+    });
+    bench::report("invoke_by_index", name, r);
+}
+
+/***************************************************************************/
+
+int main() {
+    using o4 = decltype(make_handlers(overloaded::details::make_index_sequence<4>{}));
+    using o16 = decltype(make_handlers(overloaded::details::make_index_sequence<16>{}));
+    using o64 = decltype(make_handlers(overloaded::details::make_index_sequence<64>{}));
+
+    run<4>("4", [](const o4 &o, std::size_t op, int l, int r) { return switch4(o, op, l, r); });
+    run<16>("16", [](const o16 &o, std::size_t op, int l, int r) { return switch16(o, op, l, r); });
+    run<64>("64", [](const o64 &o, std::size_t op, int l, int r) { return switch64(o, op, l, r); });
+
+    return EXIT_SUCCESS;
+}
+
+/***************************************************************************/
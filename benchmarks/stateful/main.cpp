@@ -0,0 +1,108 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// compares the stateful handlers (functors with non-const `operator()`) called through
+// the `std::function` slots, which was the only way to keep them before,
+// against the same handlers held by value and called through a non-const holder.
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+
+#include <overloaded.hpp>
+#include <benchmark.hpp>
+
+/***************************************************************************/
+
+struct byte_tag {};
+struct tick_tag {};
+
+// counts the lines of the byte stream
+struct line_parser {
+    std::uint64_t lines = 0;
+    std::uint64_t column = 0;
+
+    std::uint64_t operator()(byte_tag, std::uint8_t b) {
+        if ( b == '\n' ) {
+            ++lines;
+            column = 0;
+        } else {
+            ++column;
+        }
+
+        return lines;
+    }
+};
+
+// the token bucket refilled by the ticks
+struct rate_limiter {
+    std::uint64_t tokens = 0;
+    std::uint64_t passed = 0;
+
+    std::uint64_t operator()(tick_tag, std::uint64_t refill) {
+        tokens = std::min<std::uint64_t>(tokens + refill, 64);
+        if ( tokens != 0 ) {
+            --tokens;
+            ++passed;
+        }
+
+        return passed;
+    }
+};
+
+/***************************************************************************/
+
+enum { batch = 4096, batches = 1024 };
+
+template<typename Holder>
+void run(const char *name, Holder &o) {
+    std::uint64_t acc = 0;
+    auto r = bench::measure(batches, [&](std::size_t n) {
+        for ( std::size_t i = 0; i < batch; ++i ) {
+            acc += o(byte_tag{}, static_cast<std::uint8_t>((n + i) % 61 == 0 ? '\n' : 'a'));
+            acc += o(tick_tag{}, static_cast<std::uint64_t>(i & 1));
+        }
+        bench::do_not_optimize(acc);
+    }, batch * 2);
+    bench::report("stateful", name, r);
+}
+
+int main() {
+    {
+        auto o = overloaded::make(
+             std::function<std::uint64_t(byte_tag, std::uint8_t)>(line_parser{})
+            ,std::function<std::uint64_t(tick_tag, std::uint64_t)>(rate_limiter{})
+        );
+        run("std::function slots", o);
+    }
+    {
+        auto o = overloaded::make(line_parser{}, rate_limiter{});
+        run("held by value", o);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/***************************************************************************/
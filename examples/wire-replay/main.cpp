@@ -0,0 +1,106 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+// this example demonstrates the offline replay of the recorded calls:
+// the calls are encoded into a file, and dispatched back from its `mmap`'d image,
+// with the string parameters passed as views into the mapping.
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cassert>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <overloaded.hpp>
+#include <overloaded/wire.hpp>
+
+/***************************************************************************/
+// the handlers of the recorded calls
+
+struct book {
+    long volume = 0;
+    double last_price = 0;
+    std::vector<std::string> halted;
+};
+
+/***************************************************************************/
+
+int main() {
+    book b;
+    auto o = overloaded::make(
+         [&b](std::string_view /*symbol*/, double price, long qty) { b.last_price = price; b.volume += qty; }
+        ,[&b](std::string_view symbol) { b.halted.emplace_back(symbol); }
+    );
+
+    // recording
+    const char *path = "overloaded-wire-replay.bin";
+    {
+        std::vector<std::byte> buf;
+        overloaded::wire_encode<void(std::string_view, double, long)>(o, buf, "ABC", 10.5, 100);
+        overloaded::wire_encode<void(std::string_view, double, long)>(o, buf, "ABC", 10.75, 50);
+        overloaded::wire_encode<void(std::string_view)>(o, buf, "XYZ");
+
+        std::ofstream file{path, std::ios::binary};
+        file.write(reinterpret_cast<const char *>(buf.data()), static_cast<std::streamsize>(buf.size()));
+    }
+
+    // replaying
+    int fd = ::open(path, O_RDONLY);
+    assert(fd != -1);
+    struct stat st;
+    ::fstat(fd, &st);
+    std::size_t size = static_cast<std::size_t>(st.st_size);
+    void *image = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    assert(image != MAP_FAILED);
+
+    const std::byte *p = static_cast<const std::byte *>(image);
+    std::size_t left = size;
+    while ( std::size_t n = overloaded::dispatch_from(o, p, left) ) {
+        p += n;
+        left -= n;
+    }
+
+    ::munmap(image, size);
+    ::close(fd);
+    ::unlink(path);
+
+    // test for correctness
+    assert(left == 0);
+    assert(b.volume == 150);
+    assert(b.last_price == 10.75);
+    assert(b.halted.size() == 1 && b.halted[0] == "XYZ");
+
+    std::cout << "replayed " << size << " bytes" << std::endl;
+
+    return EXIT_SUCCESS;
+}
+
+/***************************************************************************/
@@ -1,4 +1,3 @@
-
 // The MIT License (MIT)
 //
 // Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
@@ -27,50 +26,107 @@
 #define __OVERLOADED_FUNCTION_HPP
 
 #include <functional> // to hold lambdas
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <new>
+#include <stdexcept>
+#include <cstddef>
 
-#include <boost/mpl/vector.hpp>
-#include <boost/mpl/accumulate.hpp>
-#include <boost/mpl/contains.hpp>
-#include <boost/mpl/set.hpp>
-#include <boost/mpl/size.hpp>
-#include <boost/mpl/transform.hpp>
-
-#include <boost/fusion/container/map.hpp>
-#include <boost/fusion/include/map.hpp>
-#include <boost/fusion/container/map/map_fwd.hpp>
-#include <boost/fusion/include/map_fwd.hpp>
-#include <boost/fusion/include/pair.hpp>
-#include <boost/fusion/sequence/intrinsic/has_key.hpp>
-#include <boost/fusion/include/has_key.hpp>
-#include <boost/fusion/sequence/intrinsic/at_key.hpp>
-#include <boost/fusion/include/at_key.hpp>
-
-/*************************************************************************************************/
-// I hope the fix will be accepted in 1.82
-
-#include <boost/version.hpp>
-#if BOOST_VERSION < 108200
-namespace boost {
-namespace fusion {
-
-template <typename First, typename Second>
-BOOST_CONSTEXPR BOOST_FUSION_GPU_ENABLED
-inline typename result_of::make_pair<First,Second>::type
-make_pair(Second&& val)
-{
-    return pair<First, typename detail::as_fusion_element<Second>::type>(
-        BOOST_FUSION_FWD_ELEM(Second, val));
-}
-
-} // ns fusion
-} // ns boost
-#endif // BOOST_VERSION < 108200
+#if __cplusplus >= 201703L
+#   include <variant>
+#   include <vector>
+#endif // __cplusplus >= 201703L
 
 namespace overloaded {
 namespace details {
 
 /*************************************************************************************************/
 
+template<typename... Types>
+struct type_list {};
+
+template<std::size_t... Is>
+struct index_sequence {};
+
+template<typename L, typename R>
+struct concat_index_sequence;
+
+template<std::size_t... L, std::size_t... R>
+struct concat_index_sequence<index_sequence<L...>, index_sequence<R...>> {
+    using type = index_sequence<L..., (sizeof...(L) + R)...>;
+};
+
+// logarithmic instantiation depth
+template<std::size_t N>
+struct make_index_sequence_impl: concat_index_sequence<
+     typename make_index_sequence_impl<N / 2>::type
+    ,typename make_index_sequence_impl<N - N / 2>::type
+>
+{};
+
+template<>
+struct make_index_sequence_impl<0> { using type = index_sequence<>; };
+
+template<>
+struct make_index_sequence_impl<1> { using type = index_sequence<0>; };
+
+template<std::size_t N>
+using make_index_sequence = typename make_index_sequence_impl<N>::type;
+
+template<bool... Bs>
+struct bool_pack {};
+
+template<bool... Bs>
+struct all_of: std::is_same<bool_pack<true, Bs...>, bool_pack<Bs..., true>> {};
+
+template<typename List>
+struct list_size;
+
+template<typename... Types>
+struct list_size<type_list<Types...>>: std::integral_constant<std::size_t, sizeof...(Types)> {};
+
+template<std::size_t I, typename List>
+struct type_at;
+
+template<typename T, typename... Types>
+struct type_at<0, type_list<T, Types...>> {
+    using type = T;
+};
+
+template<std::size_t I, typename T, typename... Types>
+struct type_at<I, type_list<T, Types...>>: type_at<I - 1, type_list<Types...>> {};
+
+template<typename T, typename List>
+struct index_in;
+
+template<typename T, typename... Types>
+struct index_in<T, type_list<T, Types...>>: std::integral_constant<std::size_t, 0> {};
+
+template<typename T, typename U, typename... Types>
+struct index_in<T, type_list<U, Types...>>
+    :std::integral_constant<std::size_t, 1 + index_in<T, type_list<Types...>>::value>
+{};
+
+// `To` with the constness of `From`
+template<typename From, typename To>
+struct copy_const {
+    using type = typename std::conditional<std::is_const<From>::value, const To, To>::type;
+};
+
+/*************************************************************************************************/
+
+template<typename... Args>
+struct make_args {
+    using type = type_list<
+        typename std::remove_const<
+            typename std::remove_reference<Args>::type
+        >::type...
+    >;
+};
+
 template<typename T, typename RR = typename std::remove_reference<T>::type>
 struct callable_signature
     :callable_signature<
@@ -82,115 +138,65 @@ struct callable_signature
 template<typename Ret, typename... Args>
 struct callable_signature<Ret(*)(Args...)> {
     using result_type = Ret;
-    using args = boost::mpl::vector<
-        typename std::remove_const<
-            typename std::remove_reference<Args>::type
-        >::type...
-    >;
+    using args = typename make_args<Args...>::type;
     using signature = Ret(Args...);
 };
 
-template<typename Ret>
-struct callable_signature<Ret(*)(void)> {
-    using result_type = Ret;
-    using args = boost::mpl::vector<void>;
-    using signature = Ret(void);
-};
-
 // class member function pointer
 template<typename Obj, typename Ret, typename... Args>
 struct callable_signature<Ret(Obj::*)(Args...)> {
     using result_type = Ret;
-    using args = boost::mpl::vector<
-        typename std::remove_const<
-            typename std::remove_reference<Args>::type
-        >::type...
-    >;
+    using args = typename make_args<Args...>::type;
     using signature = Ret(Args...);
 };
 
-template<typename Obj, typename Ret>
-struct callable_signature<Ret(Obj::*)(void)> {
+template<typename Obj, typename Ret, typename... Args>
+struct callable_signature<Ret(Obj::*)(Args...) const> {
     using result_type = Ret;
-    using args = boost::mpl::vector<void>;
-    using signature = Ret(void);
+    using args = typename make_args<Args...>::type;
+    using signature = Ret(Args...);
 };
 
+#ifdef __cpp_noexcept_function_type
 template<typename Obj, typename Ret, typename... Args>
-struct callable_signature<Ret(Obj::*)(Args...) const> {
+struct callable_signature<Ret(Obj::*)(Args...) noexcept> {
     using result_type = Ret;
-    using args = boost::mpl::vector<
-        typename std::remove_const<
-            typename std::remove_reference<Args>::type
-        >::type...
-    >;
+    using args = typename make_args<Args...>::type;
     using signature = Ret(Args...);
 };
 
-template<typename Obj, typename Ret>
-struct callable_signature<Ret(Obj::*)(void) const> {
+template<typename Obj, typename Ret, typename... Args>
+struct callable_signature<Ret(Obj::*)(Args...) const noexcept> {
     using result_type = Ret;
-    using args = boost::mpl::vector<void>;
-    using signature = Ret(void);
+    using args = typename make_args<Args...>::type;
+    using signature = Ret(Args...);
 };
+#endif // __cpp_noexcept_function_type
 
 // ref-to-pointer
 template<typename Ret, typename... Args>
 struct callable_signature<Ret(*&)(Args...)> {
     using result_type = Ret;
-    using args = boost::mpl::vector<
-        typename std::remove_const<
-            typename std::remove_reference<Args>::type
-        >::type...
-    >;
+    using args = typename make_args<Args...>::type;
     using signature = Ret(Args...);
 };
 
-template<typename Ret>
-struct callable_signature<Ret(*&)(void)> {
-    using result_type = Ret;
-    using args = boost::mpl::vector<void>;
-    using signature = Ret(void);
-};
-
 // reference
 template<typename Ret, typename... Args>
 struct callable_signature<Ret(&)(Args...)> {
     using result_type = Ret;
-    using args = boost::mpl::vector<
-        typename std::remove_const<
-            typename std::remove_reference<Args>::type
-        >::type...
-    >;
+    using args = typename make_args<Args...>::type;
     using signature = Ret(Args...);
 };
 
-template<typename Ret>
-struct callable_signature<Ret(&)(void)> {
-    using result_type = Ret;
-    using args = boost::mpl::vector<void>;
-    using signature = Ret(void);
-};
-
 // signature
 template<typename Ret, typename... Args>
 struct callable_signature<Ret(Args...)> {
     using result_type = Ret;
-    using args = boost::mpl::vector<
-        typename std::remove_const<
-            typename std::remove_reference<Args>::type
-        >::type...
-    >;
+    using args = typename make_args<Args...>::type;
     using signature = Ret(Args...);
 };
 
-template<typename Ret>
-struct callable_signature<Ret(void)> {
-    using result_type = Ret;
-    using args = boost::mpl::vector<void>;
-    using signature = Ret(void);
-};
-
 /*************************************************************************************************/
 
 template<bool OK, typename F, typename Decayed>
@@ -202,15 +208,16 @@ struct callable_holder_real<false, F, Decayed> {
     using type = Decayed;
 };
 
-// for any other callable type
+// for any other callable type.
+// l-value refs and non-copyable types are held as is, copyable types
+// (lambdas, functors, including `mutable` ones) are held by value
+// to keep the call inlinable.
 template<typename F, typename Decayed>
 struct callable_holder_real<true, F, Decayed> {
-    using signature = typename callable_signature<F>::signature;
-    using std_function_type = std::function<signature>;
     using type = typename std::conditional<
          std::is_lvalue_reference<F>::value || !std::is_copy_constructible<F>::value
         ,F
-        ,std_function_type
+        ,Decayed
     >::type;
 };
 
@@ -224,235 +231,2022 @@ struct callable_holder {
     >::type;
 };
 
+// is the holder callable through a const reference with the specified arguments.
+// `mutable` lambdas and functors with a non-const `operator()` are not.
+template<typename Holder, typename Args, typename = void>
+struct is_const_callable: std::false_type {};
+
+template<typename Holder, typename... Args>
+struct is_const_callable<
+     Holder
+    ,type_list<Args...>
+    ,decltype((void)std::declval<const Holder &>()(std::declval<Args>()...))
+>: std::true_type {};
+
+// the holder can be called through the `Self` overloaded_function;
+// the const check is only instantiated for the const one.
+template<typename Self, typename Holder, typename... Args>
+struct is_callable_through: std::conditional<
+     std::is_const<Self>::value
+    ,is_const_callable<Holder, type_list<Args...>>
+    ,std::true_type
+>::type
+{};
+
 /*************************************************************************************************/
 
+template<typename Arg>
+struct transform_parameter {
+    using type = typename std::conditional<
+         std::is_array<Arg>::value
+        ,typename std::add_pointer<
+            typename std::add_const<
+                typename std::remove_all_extents<Arg>::type
+            >::type
+        >::type
+        ,typename std::conditional<
+             std::is_pointer<Arg>::value && !std::is_const<Arg>::value
+            ,typename std::add_pointer<
+                typename std::add_const<
+                    typename std::remove_pointer<Arg>::type
+                >::type
+            >::type
+            ,typename std::decay<Arg>::type
+        >::type
+    >::type;
+};
+
 template<typename... Args>
 struct transform_parameters {
+    using type = type_list<
+        typename transform_parameter<Args>::type...
+    >;
+};
+
+/*************************************************************************************************/
+// the value-category preserving keys, used by `make_exact()`.
+// the rvalue-ref parameter keeps the `&&` in the key, so `f(const T &)` and
+// `f(T &&)` are different signatures. at the call site an r-value argument
+// selects the `&&` key element, see `call_key`.
+
+template<typename Param>
+struct exact_param {
     using type = typename std::conditional<
-         (sizeof...(Args) > 0)
-        ,boost::mpl::vector<
-            typename std::conditional<
-                 std::is_array<Args>::value
-                ,typename std::add_pointer<
-                    typename std::add_const<
-                        typename std::remove_all_extents<Args>::type
-                    >::type
-                >::type
-                ,typename std::conditional<
-                     std::is_pointer<Args>::value && !std::is_const<Args>::value
-                    ,typename std::add_pointer<
-                        typename std::add_const<
-                            typename std::remove_pointer<Args>::type
-                        >::type
-                    >::type
-                    ,typename std::decay<Args>::type
-                >::type
-            >::type...
-        >
-        ,boost::mpl::vector<void>
+         std::is_rvalue_reference<Param>::value
+        ,typename std::remove_const<
+            typename std::remove_reference<Param>::type
+        >::type &&
+        ,typename std::remove_const<
+            typename std::remove_reference<Param>::type
+        >::type
     >::type;
 };
 
+template<typename Signature>
+struct exact_args;
+
+template<typename Ret, typename... Params>
+struct exact_args<Ret(Params...)> {
+    using type = type_list<typename exact_param<Params>::type...>;
+};
+
 /*************************************************************************************************/
+// the calls-map is a flat class deriving from one `map_slot` per callable-elem.
+// the slot is found by the derived-to-base deduction on its key (or index), so
+// every lookup is a single overload resolution instead of a recursive search.
 
-template<bool>
-struct at_key_check_helper;
+template<typename Key, typename Holder>
+struct map_pair {
+    using key_type = Key;
+    using holder_type = Holder;
+};
 
-template<>
-struct at_key_check_helper<true> {
-    template<typename Map, typename F>
-    static bool apply(const Map &map, const F &f) {
-        return f == boost::fusion::at_key<
-            typename callable_signature<
-                typename std::remove_pointer<F>::type
-            >::args
-        >(map);
-    }
+#if __cplusplus >= 201402L
+template<typename T>
+using is_final = std::is_final<T>;
+#else
+template<typename T>
+struct is_final: std::integral_constant<bool, __is_final(T)> {};
+#endif // __cplusplus >= 201402L
+
+// the empty holders (stateless lambdas and functors) are stored as a base,
+// so they occupy no space in the calls-map.
+template<
+     typename Holder
+    ,bool = std::is_empty<Holder>::value && !is_final<Holder>::value
+>
+struct slot_storage {
+    template<typename... T>
+    explicit slot_storage(T &&...v)
+        :value(std::forward<T>(v)...)
+    {}
+
+    Holder& get() { return value; }
+    const Holder& get() const { return value; }
+
+    Holder value;
 };
 
-template<>
-struct at_key_check_helper<false> {
-    template<typename Map, typename F>
-    static bool apply(const Map &, const F &) { return false; }
+template<typename Holder>
+struct slot_storage<Holder, true>: private Holder {
+    template<typename... T>
+    explicit slot_storage(T &&...v)
+        :Holder(std::forward<T>(v)...)
+    {}
+
+    Holder& get() { return *this; }
+    const Holder& get() const { return *this; }
 };
 
-/*************************************************************************************************/
+template<std::size_t I, typename Key, typename Holder>
+struct map_slot: slot_storage<Holder> {
+    template<typename T>
+    explicit map_slot(T &&v)
+        :slot_storage<Holder>(std::forward<T>(v))
+    {}
+};
 
-template<typename Map>
-struct size_template {
-    enum { value = boost::fusion::result_of::size<Map>::value };
+template<std::size_t I, typename Key, typename Holder>
+struct slot_info {
+    enum: std::size_t { index = I };
+    using key_type = Key;
+    using holder_type = Holder;
+    using slot_type = map_slot<I, Key, Holder>;
 };
 
-template<typename Map, typename Sig>
-struct exists_template: std::integral_constant<
-     bool
-    ,boost::fusion::result_of::has_key<
-         Map
-        ,typename details::callable_signature<Sig>::args
-    >::value
->::type
-{};
+template<typename Key, std::size_t I, typename Holder>
+slot_info<I, Key, Holder> slot_info_by_key(const map_slot<I, Key, Holder> *);
 
-/*************************************************************************************************/
+template<std::size_t I, typename Key, typename Holder>
+slot_info<I, Key, Holder> slot_info_by_index(const map_slot<I, Key, Holder> *);
+
+template<typename Key, std::size_t I, typename Holder>
+map_slot<I, Key, Holder>& slot_by_key(map_slot<I, Key, Holder> &slot) { return slot; }
+
+template<typename Key, std::size_t I, typename Holder>
+const map_slot<I, Key, Holder>& slot_by_key(const map_slot<I, Key, Holder> &slot) { return slot; }
+
+template<std::size_t I, typename Key, typename Holder>
+map_slot<I, Key, Holder>& slot_by_index(map_slot<I, Key, Holder> &slot) { return slot; }
+
+template<std::size_t I, typename Key, typename Holder>
+const map_slot<I, Key, Holder>& slot_by_index(const map_slot<I, Key, Holder> &slot) { return slot; }
+
+// the `slot_info` of the key, or `no_slot_info`. the lookups are made once per key
+// (and per index) and shared by the traits below, instead of one per trait.
+struct no_slot_info {};
+
+template<typename Map, typename Key>
+struct slot_of_key {
+    template<typename M>
+    static auto test(const M *m) -> decltype(slot_info_by_key<Key>(m));
+    template<typename>
+    static no_slot_info test(...);
 
-template<typename ...Types>
-struct only_unique_sequence {
-    using vector = boost::mpl::vector<Types...>;
-    using type = typename boost::mpl::accumulate<
-        vector,
-        boost::mpl::pair<
-             typename boost::mpl::clear<vector>::type
-            ,boost::mpl::set0<>
-        >,
-        boost::mpl::if_<
-            boost::mpl::contains<
-                 boost::mpl::second<boost::mpl::_1>
-                ,boost::mpl::_2
-            >,
-            boost::mpl::_1,
-            boost::mpl::pair<
-                boost::mpl::push_back<
-                     boost::mpl::first<boost::mpl::_1>
-                    ,boost::mpl::_2
-                >,
-                boost::mpl::insert<
-                     boost::mpl::second<boost::mpl::_1>
-                    ,boost::mpl::_2
-                >
-            >
-        >
-    >::type::first;
+    using type = decltype(test<Map>(nullptr));
 };
 
-template<typename ...Funcs>
-struct map_generator {
-    using type = boost::fusion::map<
-        typename boost::fusion::pair<
-             typename details::callable_signature<Funcs>::args
-            ,typename details::callable_holder<Funcs>::type
-        >...
-    >;
+template<typename Map, std::size_t I>
+struct slot_of_index {
+    using type = decltype(slot_info_by_index<I>(static_cast<const Map *>(nullptr)));
+};
 
-    static_assert(
-        boost::fusion::result_of::size<type>::value
-            == boost::mpl::size<typename only_unique_sequence<Funcs...>::type>::value
-        ,"only unique signatures is allowed!"
-    );
+template<typename Map, typename Key>
+struct has_key {
+    enum: bool { value = !std::is_same<typename slot_of_key<Map, Key>::type, no_slot_info>::value };
 };
 
-/*************************************************************************************************/
+template<typename Map, typename Key>
+struct value_at_key {
+    using type = typename slot_of_key<Map, Key>::type::holder_type;
+};
 
-template<
-     typename... Funcs
-    ,typename FuncsMap = typename details::map_generator<Funcs...>::type
->
-FuncsMap create(Funcs &&...funcs) {
-    return {
-        boost::fusion::make_pair<
-             typename details::callable_signature<Funcs>::args
-            ,typename details::callable_holder<Funcs>::type
-        >(std::forward<Funcs>(funcs))...
-    };
+template<typename Map, typename Key>
+struct index_of_key {
+    enum: std::size_t { value = slot_of_key<Map, Key>::type::index };
+};
+
+template<typename Map, std::size_t I>
+struct value_at {
+    using type = typename slot_of_index<Map, I>::type::holder_type;
+};
+
+template<typename Map, std::size_t I>
+struct key_at {
+    using type = typename slot_of_index<Map, I>::type::key_type;
+};
+
+template<typename Holder>
+struct holder_result {
+    using type = typename callable_signature<
+        typename std::remove_pointer<
+            typename std::remove_reference<Holder>::type
+        >::type
+    >::result_type;
+};
+
+template<typename Holder>
+struct holder_signature {
+    using type = typename callable_signature<
+        typename std::remove_pointer<
+            typename std::remove_reference<Holder>::type
+        >::type
+    >::signature;
+};
+
+template<typename Signature>
+struct signature_params;
+
+template<typename Ret, typename... Params>
+struct signature_params<Ret(Params...)> {
+    using type = type_list<Params...>;
+};
+
+template<typename Key, typename Map>
+auto at_key(Map &map) -> decltype(slot_by_key<Key>(map).get()) {
+    return slot_by_key<Key>(map).get();
 }
 
-/*************************************************************************************************/
+template<typename Key, typename Map>
+auto move_at_key(Map &map) -> typename std::add_rvalue_reference<
+    typename value_at_key<Map, Key>::type
+>::type
+{
+    using holder_type = typename value_at_key<Map, Key>::type;
+    return static_cast<typename std::add_rvalue_reference<holder_type>::type>(
+        slot_by_key<Key>(map).get()
+    );
+}
 
-template<typename Sig, typename Map>
-constexpr bool exists(const Map &) {
-    return details::exists_template<Map, Sig>::value;
+template<std::size_t I, typename Map>
+auto at(Map &map) -> decltype(slot_by_index<I>(map).get()) {
+    return slot_by_index<I>(map).get();
 }
 
-template<typename Map, typename F>
-bool exists(const Map &map, F &&f) {
-    enum { value = details::exists_template<Map, typename std::remove_pointer<F>::type>::value };
-    return value && details::at_key_check_helper<value>::apply(map, std::forward<F>(f));
+// the holder of the I-th slot: as is for the l-value map, moved out of the r-value one
+template<std::size_t I, typename Map>
+auto forward_at(Map &map, std::true_type /*lvalue*/) -> decltype(at<I>(map)) {
+    return at<I>(map);
+}
+
+template<std::size_t I, typename Map>
+auto forward_at(Map &map, std::false_type /*lvalue*/) -> typename std::add_rvalue_reference<
+    typename value_at<Map, I>::type
+>::type
+{
+    using holder_type = typename value_at<Map, I>::type;
+    return static_cast<typename std::add_rvalue_reference<holder_type>::type>(
+        slot_by_index<I>(map).get()
+    );
 }
 
 /*************************************************************************************************/
 
-} // ns details
+struct construct_tag {};
+struct splice_tag {};
 
-/*************************************************************************************************/
+template<typename Indices, typename... Pairs>
+struct flat_map_storage;
 
-template<typename Map>
-struct overloaded_function {
-    template<typename Map2>
-    overloaded_function(Map2 &&map)
-        :map{std::forward<Map2>(map)}
+template<std::size_t... Is, typename... Keys, typename... Holders>
+struct flat_map_storage<index_sequence<Is...>, map_pair<Keys, Holders>...>
+    :map_slot<Is, Keys, Holders>...
+{
+    template<typename... Ts>
+    explicit flat_map_storage(construct_tag, Ts &&...vs)
+        :map_slot<Is, Keys, Holders>(std::forward<Ts>(vs))...
     {}
+};
 
-    static constexpr std::size_t size() {
-        return boost::fusion::result_of::size<Map>::value;
-    }
-    template<typename Signature>
-    static constexpr bool exists() {
-        return details::exists_template<Map, Signature>::value;
-    }
+template<typename... Pairs>
+struct flat_map: flat_map_storage<make_index_sequence<sizeof...(Pairs)>, Pairs...> {
+    using base_type = flat_map_storage<make_index_sequence<sizeof...(Pairs)>, Pairs...>;
+    using keys = type_list<typename Pairs::key_type...>;
+    using holders = type_list<typename Pairs::holder_type...>;
 
-    template<
-         typename ...Args
-        ,typename Ret = typename details::callable_signature<
-            typename std::remove_pointer<
-                typename std::remove_reference<
-                    typename boost::fusion::result_of::at_key<
-                         Map
-                        ,typename details::transform_parameters<Args...>::type
-                    >::type
-                >::type
-            >::type
-        >::result_type
-    >
-    Ret invoke(Args &&...args) const {
-        using types = typename details::transform_parameters<Args...>::type;
+    template<typename... Ts>
+    explicit flat_map(construct_tag tag, Ts &&...vs)
+        :base_type(tag, std::forward<Ts>(vs)...)
+    {}
+
+    // converts key-by-key from a map with the same signatures but different holders
+    template<typename... Pairs2>
+    flat_map(const flat_map<Pairs2...> &r)
+        :base_type(construct_tag{}, at_key<typename Pairs::key_type>(r)...)
+    {
         static_assert(
-             boost::fusion::result_of::has_key<Map, types>::value
-            ,"calls-map doesn't contains callable-elem with specified parameters"
+             sizeof...(Pairs) == sizeof...(Pairs2)
+            ,"calls-maps with the different number of signatures is not convertible"
         );
-
-        return boost::fusion::at_key<types>(map)(std::forward<Args>(args)...);
     }
-    template<
-         typename ...Args
-        ,typename Ret = typename details::callable_signature<
-            typename std::remove_pointer<
-                typename std::remove_reference<
-                    typename boost::fusion::result_of::at_key<
-                        Map
-                        ,typename details::transform_parameters<Args...>::type
-                    >::type
-                >::type
-            >::type
-        >::result_type
-    >
-    Ret operator()(Args &&...args) const {
-        using types = typename details::transform_parameters<Args...>::type;
+    template<typename... Pairs2>
+    flat_map(flat_map<Pairs2...> &&r)
+        :base_type(construct_tag{}, move_at_key<typename Pairs::key_type>(r)...)
+    {
         static_assert(
-             boost::fusion::result_of::has_key<Map, types>::value
-            ,"calls-map doesn't contains callable-elem with specified parameters"
+             sizeof...(Pairs) == sizeof...(Pairs2)
+            ,"calls-maps with the different number of signatures is not convertible"
         );
-
-        return boost::fusion::at_key<types>(map)(std::forward<Args>(args)...);
     }
 
-private:
-    Map map;
+    flat_map(const flat_map &) = default;
+    flat_map(flat_map &&) = default;
+    flat_map& operator= (const flat_map &) = default;
+    flat_map& operator= (flat_map &&) = default;
 };
 
+template<typename Map>
+struct map_size;
+
+template<typename... Pairs>
+struct map_size<flat_map<Pairs...>>: std::integral_constant<std::size_t, sizeof...(Pairs)> {};
+
 /*************************************************************************************************/
 
-template<typename ...Funcs>
-struct make_overloaded {
-    using type = overloaded_function<typename details::map_generator<Funcs...>::type>;
+template<typename Map>
+struct size_template {
+    enum { value = map_size<Map>::value };
+};
+
+// the key to be used for the specified signature: the exact one if the map has it
+template<typename Map, typename Sig>
+struct signature_key {
+    using exact = typename exact_args<typename callable_signature<Sig>::signature>::type;
+    using type = typename std::conditional<
+         has_key<Map, exact>::value
+        ,exact
+        ,typename callable_signature<Sig>::args
+    >::type;
 };
 
 /*************************************************************************************************/
+// the overload resolution probes: a set of the overloaded `probe()` declarations,
+// one per slot, so the compiler's own overload resolution selects the slot.
 
-template<
-     typename... Funcs
-    ,typename FuncsMap = typename details::map_generator<Funcs...>::type
->
-auto make(Funcs &&...funcs) -> overloaded_function<FuncsMap> {
-    return {details::create(std::forward<Funcs>(funcs)...)};
+constexpr std::size_t no_slot = static_cast<std::size_t>(-1);
+
+template<std::size_t I, typename Signature>
+struct slot_probe;
+
+template<std::size_t I, typename Ret, typename... Params>
+struct slot_probe<I, Ret(Params...)> {
+    static std::integral_constant<std::size_t, I> probe(Params...);
+};
+
+template<typename... Probes>
+struct probe_set;
+
+template<typename Probe>
+struct probe_set<Probe>: Probe {
+    using Probe::probe;
+};
+
+template<typename Probe, typename... Probes>
+struct probe_set<Probe, Probes...>: Probe, probe_set<Probes...> {
+    using Probe::probe;
+    using probe_set<Probes...>::probe;
+};
+
+// the index of the slot selected by the probes, or `no_slot`
+template<typename Probes, typename... Args>
+struct probe_result {
+    template<typename P>
+    static auto test(int) -> decltype(P::probe(std::declval<Args>()...));
+    template<typename>
+    static std::integral_constant<std::size_t, no_slot> test(...);
+
+    static constexpr std::size_t value = decltype(test<Probes>(0))::value;
+};
+
+template<bool... Bs>
+struct count_true;
+
+template<>
+struct count_true<>: std::integral_constant<std::size_t, 0> {};
+
+template<bool B, bool... Bs>
+struct count_true<B, Bs...>: std::integral_constant<std::size_t, B + count_true<Bs...>::value> {};
+
+/*************************************************************************************************/
+// the key to be used for the call-site arguments.
+// for the maps with the `&&` keys (see `make_exact()`) the value category is matched
+// per parameter: every key with the same decayed types, whose `&&` elements are taken
+// by the r-value arguments, is a candidate, and the candidates are ranked as the
+// `const T &` and the `T &&` overloads are. the others use the decayed key directly.
+
+template<typename Key>
+struct key_has_rvalue;
+
+template<typename... Elems>
+struct key_has_rvalue<type_list<Elems...>>
+    :std::integral_constant<bool, !all_of<!std::is_rvalue_reference<Elems>::value...>::value>
+{};
+
+template<typename Keys>
+struct has_rvalue_keys;
+
+template<typename... Keys>
+struct has_rvalue_keys<type_list<Keys...>>
+    :std::integral_constant<bool, !all_of<!key_has_rvalue<Keys>::value...>::value>
+{};
+
+template<typename Elem, typename Arg>
+struct exact_elem_matches: std::integral_constant<
+     bool
+    ,std::is_same<Elem, typename transform_parameter<Arg>::type>::value
+        || (!std::is_lvalue_reference<Arg>::value
+            && std::is_same<Elem, typename transform_parameter<Arg>::type &&>::value)
+>
+{};
+
+template<typename Key, typename ArgList, typename = void>
+struct exact_key_matches: std::false_type {};
+
+template<typename... Elems, typename... Args>
+struct exact_key_matches<
+     type_list<Elems...>
+    ,type_list<Args...>
+    ,typename std::enable_if<sizeof...(Elems) == sizeof...(Args)>::type
+>: all_of<exact_elem_matches<Elems, Args>::value...>
+{};
+
+template<std::size_t I, typename Key>
+struct exact_probe;
+
+template<std::size_t I, typename... Elems>
+struct exact_probe<I, type_list<Elems...>> {
+    static std::integral_constant<std::size_t, I> probe(
+        typename std::conditional<std::is_rvalue_reference<Elems>::value, Elems, const Elems &>::type...
+    );
+};
+
+// the probe of the slot which is not a candidate
+template<std::size_t I>
+struct unmatched_probe {
+    struct never {};
+    static void probe(never);
+};
+
+// the key of the call for which several candidates are equally good
+struct ambiguous_call_key {};
+
+template<typename Map, typename Indices, typename... Args>
+struct exact_call_key_impl;
+
+template<typename Map, std::size_t... Is, typename... Args>
+struct exact_call_key_impl<Map, index_sequence<Is...>, Args...> {
+    template<std::size_t I>
+    using matches = exact_key_matches<typename key_at<Map, I>::type, type_list<Args...>>;
+    using probes = probe_set<
+        typename std::conditional<
+             matches<Is>::value
+            ,exact_probe<Is, typename key_at<Map, Is>::type>
+            ,unmatched_probe<Is>
+        >::type...
+    >;
+
+    static constexpr std::size_t index = probe_result<probes, Args...>::value;
+    static constexpr bool candidates = count_true<matches<Is>::value...>::value != 0;
+};
+
+template<typename Map, bool Decayed, typename... Args>
+struct call_key_impl {
+    using type = typename transform_parameters<Args...>::type;
+};
+
+template<typename Map, typename... Args>
+struct call_key_impl<Map, false, Args...> {
+    using impl = exact_call_key_impl<Map, make_index_sequence<map_size<Map>::value>, Args...>;
+    using type = typename std::conditional<
+         impl::index != no_slot
+        ,typename key_at<Map, impl::index != no_slot ? impl::index : 0>::type
+        ,typename std::conditional<
+             impl::candidates
+            ,ambiguous_call_key
+            ,typename transform_parameters<Args...>::type
+        >::type
+    >::type;
+};
+
+template<typename Map, typename... Args>
+struct call_key: call_key_impl<
+     Map
+    ,!has_rvalue_keys<typename Map::keys>::value
+        || all_of<std::is_lvalue_reference<Args>::value...>::value
+    ,Args...
+>
+{};
+
+template<typename Map, typename Sig>
+struct exists_template: std::integral_constant<
+     bool
+    ,has_key<
+         Map
+        ,typename signature_key<Map, Sig>::type
+    >::value
+>::type
+{};
+
+/*************************************************************************************************/
+
+template<bool>
+struct at_key_check_helper;
+
+template<>
+struct at_key_check_helper<true> {
+    template<typename Map, typename F>
+    static bool apply(const Map &map, const F &f) {
+        return f == at_key<
+            typename signature_key<
+                 Map
+                ,typename std::remove_pointer<F>::type
+            >::type
+        >(map);
+    }
+};
+
+template<>
+struct at_key_check_helper<false> {
+    template<typename Map, typename F>
+    static bool apply(const Map &, const F &) { return false; }
+};
+
+/*************************************************************************************************/
+
+// a key is found by `has_key` only when it's the single one in the map,
+// so the map is unique if every its key is found.
+template<typename Map, typename Keys = typename Map::keys>
+struct only_unique_keys;
+
+template<typename Map, typename... Keys>
+struct only_unique_keys<Map, type_list<Keys...>>
+    :all_of<has_key<Map, Keys>::value...>
+{};
+
+template<typename F>
+struct decayed_key {
+    using type = typename callable_signature<F>::args;
+};
+
+template<typename F>
+struct exact_key {
+    using type = typename exact_args<typename callable_signature<F>::signature>::type;
+};
+
+template<template<typename> class KeyOf, typename ...Funcs>
+struct flat_map_of {
+    using type = flat_map<
+        map_pair<
+             typename KeyOf<Funcs>::type
+            ,typename details::callable_holder<Funcs>::type
+        >...
+    >;
+};
+
+template<template<typename> class KeyOf, typename ...Funcs>
+struct basic_map_generator: flat_map_of<KeyOf, Funcs...> {
+    static_assert(
+         only_unique_keys<typename flat_map_of<KeyOf, Funcs...>::type>::value
+        ,"only unique signatures is allowed!"
+    );
+};
+
+template<typename ...Funcs>
+struct map_generator: basic_map_generator<decayed_key, Funcs...> {};
+
+template<typename ...Funcs>
+struct exact_map_generator: basic_map_generator<exact_key, Funcs...> {};
+
+// the calls-map where several callable-elems may share a signature, see `make_multi()`
+template<typename ...Funcs>
+struct multi_map_generator: flat_map_of<decayed_key, Funcs...> {};
+
+// the number of the callable-elems with the specified key
+template<typename Key, typename Keys>
+struct key_count;
+
+template<typename Key>
+struct key_count<Key, type_list<>>: std::integral_constant<std::size_t, 0> {};
+
+template<typename Key, typename K, typename... Keys>
+struct key_count<Key, type_list<K, Keys...>>: std::integral_constant<
+     std::size_t
+    ,std::is_same<Key, K>::value + key_count<Key, type_list<Keys...>>::value
+>
+{};
+
+/*************************************************************************************************/
+// `merge()`/`extend()` support: the spliced calls-map is the selected slots of
+// the left map followed by all the slots of the right one, with the same holders.
+
+template<typename LKeys, typename RKeys>
+struct no_shared_keys;
+
+template<typename... LKeys, typename RKeys>
+struct no_shared_keys<type_list<LKeys...>, RKeys>
+    :all_of<(key_count<LKeys, RKeys>::value == 0)...>
+{};
+
+// the indices of the left slots which are not overridden by the right keys
+template<typename RKeys, typename Kept, std::size_t I, typename LKeys>
+struct unshadowed_indices;
+
+template<typename RKeys, std::size_t... Kept, std::size_t I>
+struct unshadowed_indices<RKeys, index_sequence<Kept...>, I, type_list<>> {
+    using type = index_sequence<Kept...>;
+};
+
+template<typename RKeys, std::size_t... Kept, std::size_t I, typename K, typename... LKeys>
+struct unshadowed_indices<RKeys, index_sequence<Kept...>, I, type_list<K, LKeys...>>
+    :unshadowed_indices<
+         RKeys
+        ,typename std::conditional<
+             key_count<K, RKeys>::value == 0
+            ,index_sequence<Kept..., I>
+            ,index_sequence<Kept...>
+        >::type
+        ,I + 1
+        ,type_list<LKeys...>
+    >
+{};
+
+template<typename L, typename R, typename LIndices>
+struct splice_map;
+
+template<typename L, typename... RPairs, std::size_t... Ls>
+struct splice_map<L, flat_map<RPairs...>, index_sequence<Ls...>> {
+    using type = flat_map<
+         map_pair<typename key_at<L, Ls>::type, typename value_at<L, Ls>::type>...
+        ,RPairs...
+    >;
+    using left_indices = index_sequence<Ls...>;
+    using right_indices = make_index_sequence<sizeof...(RPairs)>;
+};
+
+template<typename L, typename R>
+struct merge_map: splice_map<L, R, make_index_sequence<map_size<L>::value>> {
+    static_assert(
+         no_shared_keys<typename L::keys, typename R::keys>::value
+        ,"the merged calls-maps contain the same signature, use `merge_override()`"
+    );
+};
+
+// the right callable-elem wins for the signature existing in both maps
+template<typename L, typename R>
+struct override_map: splice_map<
+     L
+    ,R
+    ,typename unshadowed_indices<typename R::keys, index_sequence<>, 0, typename L::keys>::type
+>
+{};
+
+/*************************************************************************************************/
+// `invoke_best()` support: the stored signatures are turned into a set of the
+// overloaded `probe()` declarations, so the compiler's own overload resolution
+// selects the slot by the implicit-conversion ranking of the call-site arguments.
+
+template<typename Map, typename Indices, typename... Args>
+struct best_viable_impl;
+
+template<typename Map, std::size_t... Is, typename... Args>
+struct best_viable_impl<Map, index_sequence<Is...>, Args...> {
+    template<std::size_t I>
+    using probe_type = slot_probe<I, typename holder_signature<typename value_at<Map, I>::type>::type>;
+
+    static constexpr std::size_t viable =
+        count_true<(probe_result<probe_type<Is>, Args...>::value != no_slot)...>::value;
+    static constexpr std::size_t index = probe_result<probe_set<probe_type<Is>...>, Args...>::value;
+};
+
+template<typename Map, typename... Args>
+struct best_viable: best_viable_impl<Map, make_index_sequence<map_size<Map>::value>, Args...> {
+    using base_type = best_viable_impl<Map, make_index_sequence<map_size<Map>::value>, Args...>;
+
+    static constexpr bool found = base_type::index != no_slot;
+    static constexpr bool ambiguous = !found && base_type::viable > 1;
+    // falls back to the first slot to let the diagnostics of `invoke_best()` fire
+    static constexpr std::size_t value = found ? base_type::index : 0;
+};
+
+/*************************************************************************************************/
+
+// `invoke_by_index()` support: a callable-elem can be called by the runtime index
+// when its key is the call-site key, or the call-site key preceded by an empty tag.
+
+template<typename>
+struct always_false: std::false_type {};
+
+struct not_index_callable {};
+
+template<typename Key, typename CallKey>
+struct index_call_tag {
+    using type = not_index_callable;
+};
+
+template<typename... Args>
+struct index_call_tag<type_list<Args...>, type_list<Args...>> {
+    using type = void;
+};
+
+template<typename Tag, typename... Args>
+struct index_call_tag<type_list<Tag, Args...>, type_list<Args...>> {
+    using type = Tag;
+};
+
+template<typename Tag>
+struct index_caller {
+    static_assert(
+         std::is_empty<Tag>::value && std::is_default_constructible<Tag>::value
+        ,"the first parameter of callable-elem must be an empty tag to be called by index"
+    );
+
+    template<typename Ret, typename F, typename... Args>
+    static Ret apply(F &&f, Args &&...args) {
+        return f(Tag{}, std::forward<Args>(args)...);
+    }
+};
+
+template<>
+struct index_caller<void> {
+    template<typename Ret, typename F, typename... Args>
+    static Ret apply(F &&f, Args &&...args) {
+        return f(std::forward<Args>(args)...);
+    }
+};
+
+template<>
+struct index_caller<not_index_callable> {
+    template<typename Ret, typename F, typename... Args>
+    static Ret apply(F &&, Args &&...) {
+        static_assert(
+             always_false<F>::value
+            ,"every callable-elem must accept the parameters passed to invoke_by_index()"
+        );
+    }
+};
+
+/*************************************************************************************************/
+// `invoke_each()` support
+
+// used in place of the output iterator when the results are not needed
+struct discard_output {};
+
+template<typename F, typename OutputIterator, typename... Args>
+void call_and_store(F &&f, OutputIterator &out, Args &&...args) {
+    *out = f(std::forward<Args>(args)...);
+    ++out;
+}
+
+template<typename F, typename... Args>
+void call_and_store(F &&f, discard_output &, Args &&...args) {
+    f(std::forward<Args>(args)...);
+}
+
+/*************************************************************************************************/
+
+template<
+     typename... Funcs
+    ,typename FuncsMap = typename details::map_generator<Funcs...>::type
+>
+FuncsMap create(Funcs &&...funcs) {
+    return FuncsMap{construct_tag{}, std::forward<Funcs>(funcs)...};
+}
+
+/*************************************************************************************************/
+
+template<typename Sig, typename Map>
+constexpr bool exists(const Map &) {
+    return details::exists_template<Map, Sig>::value;
+}
+
+template<typename Map, typename F>
+bool exists(const Map &map, F &&f) {
+    enum { value = details::exists_template<Map, typename std::remove_pointer<F>::type>::value };
+    return value && details::at_key_check_helper<value>::apply(map, std::forward<F>(f));
+}
+
+/*************************************************************************************************/
+
+} // ns details
+
+/*************************************************************************************************/
+// the function pointer known at compile time, as an empty callable.
+// the call is direct and inlinable, and the slot holding it occupies no space.
+
+template<typename F, F f>
+struct function_constant;
+
+template<typename Ret, typename... Args, Ret(*F)(Args...)>
+struct function_constant<Ret(*)(Args...), F> {
+    Ret operator()(Args... args) const { return F(std::forward<Args>(args)...); }
+};
+
+#if __cplusplus >= 201703L
+// fn<&f>
+template<auto F>
+using fn = function_constant<decltype(F), F>;
+#endif // __cplusplus >= 201703L
+
+// the same as `fn<&f>` for C++11/14
+#define OVERLOADED_FN(f) \
+    ::overloaded::function_constant<decltype(&f), &f>
+
+/*************************************************************************************************/
+// the object pointer bound with the member function pointer known at compile time.
+// the call is direct and inlinable, and the holder is the size of a pointer.
+
+template<typename MemFn, MemFn M>
+struct bound_member;
+
+template<typename Obj, typename Ret, typename... Args, Ret(Obj::*M)(Args...)>
+struct bound_member<Ret(Obj::*)(Args...), M> {
+    explicit bound_member(Obj &obj)
+        :obj{&obj}
+    {}
+
+    Ret operator()(Args... args) const { return (obj->*M)(std::forward<Args>(args)...); }
+
+    Obj *obj;
+};
+
+template<typename Obj, typename Ret, typename... Args, Ret(Obj::*M)(Args...) const>
+struct bound_member<Ret(Obj::*)(Args...) const, M> {
+    explicit bound_member(const Obj &obj)
+        :obj{&obj}
+    {}
+
+    Ret operator()(Args... args) const { return (obj->*M)(std::forward<Args>(args)...); }
+
+    const Obj *obj;
+};
+
+// the same, but the member function pointer is stored at run time
+template<typename MemFn>
+struct bound_member_ptr;
+
+template<typename Obj, typename Ret, typename... Args>
+struct bound_member_ptr<Ret(Obj::*)(Args...)> {
+    bound_member_ptr(Obj &obj, Ret(Obj::*mem)(Args...))
+        :obj{&obj}
+        ,mem{mem}
+    {}
+
+    Ret operator()(Args... args) const { return (obj->*mem)(std::forward<Args>(args)...); }
+
+    Obj *obj;
+    Ret(Obj::*mem)(Args...);
+};
+
+template<typename Obj, typename Ret, typename... Args>
+struct bound_member_ptr<Ret(Obj::*)(Args...) const> {
+    bound_member_ptr(const Obj &obj, Ret(Obj::*mem)(Args...) const)
+        :obj{&obj}
+        ,mem{mem}
+    {}
+
+    Ret operator()(Args... args) const { return (obj->*mem)(std::forward<Args>(args)...); }
+
+    const Obj *obj;
+    Ret(Obj::*mem)(Args...) const;
+};
+
+// bind_member<decltype(&Obj::fn), &Obj::fn>(obj), or OVERLOADED_BIND_MEMBER(obj, &Obj::fn)
+template<typename MemFn, MemFn M, typename Obj>
+bound_member<MemFn, M> bind_member(Obj &obj) {
+    return bound_member<MemFn, M>{obj};
+}
+
+#if __cplusplus >= 201703L
+// bind_member<&Obj::fn>(obj)
+template<auto M, typename Obj>
+bound_member<decltype(M), M> bind_member(Obj &obj) {
+    return bound_member<decltype(M), M>{obj};
+}
+#endif // __cplusplus >= 201703L
+
+// bind_member(obj, &Obj::fn)
+template<typename Obj, typename MemFn>
+bound_member_ptr<MemFn> bind_member(Obj &obj, MemFn mem) {
+    return bound_member_ptr<MemFn>{obj, mem};
+}
+
+#define OVERLOADED_BIND_MEMBER(obj, mem) \
+    ::overloaded::bind_member<decltype(mem), mem>(obj)
+
+/*************************************************************************************************/
+// non-allocating type-erased holder with a fixed-size in-place storage.
+// the callable is invoked through a single function pointer, and the one which
+// doesn't fit into the `Capacity` bytes is rejected at compile time.
+
+template<
+     typename Signature
+    ,std::size_t Capacity
+    ,std::size_t Align = alignof(std::max_align_t)
+>
+struct inplace_function;
+
+template<typename Ret, typename... Args, std::size_t Capacity, std::size_t Align>
+struct inplace_function<Ret(Args...), Capacity, Align> {
+    template<
+         typename F
+        ,typename D = typename std::decay<F>::type
+        ,typename = typename std::enable_if<
+            !std::is_same<D, inplace_function>::value
+        >::type
+    >
+    inplace_function(F &&f)
+        :m_invoke{&invoke_impl<D>}
+        ,m_manage{&manage_impl<D>}
+    {
+        static_assert(
+             sizeof(D) <= Capacity
+            ,"callable-elem doesn't fit into the inplace_function storage, increase the capacity"
+        );
+        static_assert(
+             Align % alignof(D) == 0
+            ,"callable-elem alignment is not compatible with the inplace_function storage"
+        );
+        static_assert(
+             std::is_copy_constructible<D>::value
+            ,"callable-elem must be copy constructible"
+        );
+        static_assert(
+             std::is_nothrow_move_constructible<D>::value
+            ,"callable-elem must be nothrow move constructible"
+        );
+
+        ::new(static_cast<void *>(m_storage)) D(std::forward<F>(f));
+    }
+    inplace_function(const inplace_function &r)
+        :m_invoke{r.m_invoke}
+        ,m_manage{r.m_manage}
+    { m_manage(op_copy, m_storage, r.m_storage); }
+    inplace_function(inplace_function &&r) noexcept
+        :m_invoke{r.m_invoke}
+        ,m_manage{r.m_manage}
+    { m_manage(op_move, m_storage, r.m_storage); }
+
+    // the copy is made aside, so `*this` is intact if it throws
+    inplace_function& operator= (const inplace_function &r) {
+        if ( this != &r ) {
+            inplace_function tmp(r);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+    inplace_function& operator= (inplace_function &&r) noexcept {
+        if ( this != &r ) {
+            m_manage(op_destroy, m_storage, nullptr);
+            m_invoke = r.m_invoke;
+            m_manage = r.m_manage;
+            m_manage(op_move, m_storage, r.m_storage);
+        }
+        return *this;
+    }
+
+    ~inplace_function() { m_manage(op_destroy, m_storage, nullptr); }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+    Ret operator()(Args... args) const {
+        return m_invoke(m_storage, std::forward<Args>(args)...);
+    }
+
+private:
+    enum operation { op_copy, op_move, op_destroy };
+
+    using invoke_type = Ret(*)(void *, Args&&...);
+    using manage_type = void(*)(operation, void *, void *);
+
+    template<typename D>
+    static Ret invoke_impl(void *p, Args&&... args) {
+        return (*static_cast<D *>(p))(std::forward<Args>(args)...);
+    }
+    template<typename D>
+    static void manage_impl(operation op, void *dst, void *src) {
+        switch ( op ) {
+            case op_copy: ::new(dst) D(*static_cast<const D *>(src)); break;
+            case op_move: ::new(dst) D(std::move(*static_cast<D *>(src))); break;
+            case op_destroy: static_cast<D *>(dst)->~D(); break;
+        }
+    }
+
+    alignas(Align) mutable unsigned char m_storage[Capacity];
+    invoke_type m_invoke;
+    manage_type m_manage;
+};
+
+/*************************************************************************************************/
+// the ranges to be passed to `overloaded_function::invoke_each()` element-wise
+
+template<typename... Ranges>
+struct zipped_ranges {
+    std::tuple<Ranges &...> ranges;
+};
+
+template<typename T>
+struct is_zipped_ranges: std::false_type {};
+
+template<typename... Ranges>
+struct is_zipped_ranges<zipped_ranges<Ranges...>>: std::true_type {};
+
+template<typename... Ranges>
+zipped_ranges<Ranges...> zip(Ranges &...ranges) {
+    return {std::tuple<Ranges &...>{ranges...}};
+}
+
+/*************************************************************************************************/
+
+template<typename... Types>
+using type_list = details::type_list<Types...>;
+
+// the id of the class `T` in the class list `Types`, to be returned by the `dispatch_id()`
+// of its objects, see `overloaded_function::dispatch()`
+template<typename T, typename Types>
+struct dispatch_id_of: details::index_in<T, Types> {};
+
+/*************************************************************************************************/
+
+// the policy hooks the calls made through `invoke()`/`operator()`: the
+// `Policy::scope<Map, I>` is constructed from the policy and the call-site arguments
+// right before the call of the `I`-th callable-elem, and is destroyed right after it.
+// the default policy does nothing, and is compiled away completely.
+struct no_policy {
+    template<typename Map, std::size_t I>
+    struct scope {
+        template<typename... Args>
+        explicit scope(const no_policy &, const Args &...) {}
+    };
+};
+
+template<typename Map, typename Policy = no_policy>
+struct overloaded_function;
+
+template<typename T>
+struct is_overloaded_function: std::false_type {};
+
+template<typename Map, typename Policy>
+struct is_overloaded_function<overloaded_function<Map, Policy>>: std::true_type {};
+
+namespace details {
+
+// the overloaded_function with the calls-map spliced from `L` and `R`, see `merge()`
+template<template<typename, typename> class Splice, typename L, typename R>
+struct spliced_function {
+    using splice_type = Splice<L, R>;
+    using type = overloaded_function<typename splice_type::type>;
+};
+
+template<
+     template<typename, typename> class Splice
+    ,typename L
+    ,typename R
+    ,typename Spliced = spliced_function<
+         Splice
+        ,typename std::decay<L>::type::map_type
+        ,typename std::decay<R>::type::map_type
+    >
+>
+typename Spliced::type splice(L &&l, R &&r) {
+    using splice_type = typename Spliced::splice_type;
+    return typename Spliced::type{
+         splice_tag{}
+        ,std::forward<L>(l)
+        ,typename splice_type::left_indices{}
+        ,std::forward<R>(r)
+        ,typename splice_type::right_indices{}
+    };
+}
+
+} // ns details
+
+// the calls-map made only of empty holders is stored as a base,
+// so such an overloaded_function is an empty class too. the same for the policy.
+template<typename Map, typename Policy>
+struct overloaded_function
+    :private details::slot_storage<Map>
+    ,private details::slot_storage<Policy>
+{
+    using map_type = Map;
+    using policy_type = Policy;
+
+    template<
+         typename Map2
+        ,typename = typename std::enable_if<
+            !is_overloaded_function<typename std::decay<Map2>::type>::value
+        >::type
+    >
+    overloaded_function(Map2 &&map)
+        :storage_type(std::forward<Map2>(map))
+    {}
+    template<typename... Funcs>
+    explicit overloaded_function(details::construct_tag tag, Funcs &&...funcs)
+        :storage_type(tag, std::forward<Funcs>(funcs)...)
+    {}
+
+    // converts slot-by-slot from an overloaded_function with the same signatures
+    // but different holders, for example lambdas into `make_overloaded_inplace` slots
+    template<typename Map2>
+    overloaded_function(const overloaded_function<Map2, Policy> &r)
+        :storage_type(r.map())
+        ,policy_storage_type(r.policy())
+    {}
+    template<typename Map2>
+    overloaded_function(overloaded_function<Map2, Policy> &&r)
+        :storage_type(std::move(r.map()))
+        ,policy_storage_type(r.policy())
+    {}
+
+    // the same as the above, but with the specified policy instead of the `r`'s one
+    template<typename Map2, typename Policy2>
+    overloaded_function(const overloaded_function<Map2, Policy2> &r, Policy policy)
+        :storage_type(r.map())
+        ,policy_storage_type(std::move(policy))
+    {}
+    template<typename Map2, typename Policy2>
+    overloaded_function(overloaded_function<Map2, Policy2> &&r, Policy policy)
+        :storage_type(std::move(r.map()))
+        ,policy_storage_type(std::move(policy))
+    {}
+
+    // splices the calls-maps: the `Ls` slots of `l` followed by the `Rs` slots of `r`.
+    // the holders are copied from the l-values and moved out of the r-values, see `merge()`
+    template<typename L, std::size_t... Ls, typename R, std::size_t... Rs>
+    overloaded_function(
+         details::splice_tag
+        ,L &&l
+        ,details::index_sequence<Ls...>
+        ,R &&r
+        ,details::index_sequence<Rs...>)
+        :storage_type(
+             details::construct_tag{}
+            ,details::forward_at<Ls>(l.map(), std::is_lvalue_reference<L>{})...
+            ,details::forward_at<Rs>(r.map(), std::is_lvalue_reference<R>{})...
+        )
+    {}
+
+    static constexpr std::size_t size() {
+        return details::map_size<Map>::value;
+    }
+    const Policy& policy() const { return policy_storage_type::get(); }
+
+    template<typename Signature>
+    static constexpr bool exists() {
+        return details::exists_template<Map, Signature>::value;
+    }
+    // the index of callable-elem with the specified signature, to be used with `invoke_by_index()`
+    template<typename Signature>
+    static constexpr std::size_t index_of() {
+        return details::index_of_key<
+             Map
+            ,typename details::signature_key<Map, Signature>::type
+        >::value;
+    }
+
+    // the callable-elem with the specified signature, for example to re-bind a `hot_swappable` one
+    template<
+         typename Signature
+        ,typename Key = typename details::signature_key<Map, Signature>::type
+    >
+    typename details::value_at_key<Map, Key>::type& get() {
+        return details::at_key<Key>(map());
+    }
+    template<
+         typename Signature
+        ,typename Key = typename details::signature_key<Map, Signature>::type
+    >
+    const typename details::value_at_key<Map, Key>::type& get() const {
+        return details::at_key<Key>(map());
+    }
+
+    // the const overloads require the callable-elem to be callable through a const reference,
+    // the non-const ones also call the `mutable` lambdas and the stateful functors in place.
+    template<
+         typename ...Args
+        ,typename Ret = typename details::holder_result<
+            typename details::value_at_key<
+                 Map
+                ,typename details::call_key<Map, Args...>::type
+            >::type
+        >::type
+    >
+    Ret invoke(Args &&...args) const {
+        return call<Ret>(*this, std::forward<Args>(args)...);
+    }
+    template<
+         typename ...Args
+        ,typename Ret = typename details::holder_result<
+            typename details::value_at_key<
+                 Map
+                ,typename details::call_key<Map, Args...>::type
+            >::type
+        >::type
+    >
+    Ret invoke(Args &&...args) {
+        return call<Ret>(*this, std::forward<Args>(args)...);
+    }
+    template<
+         typename ...Args
+        ,typename Ret = typename details::holder_result<
+            typename details::value_at_key<
+                 Map
+                ,typename details::call_key<Map, Args...>::type
+            >::type
+        >::type
+    >
+    Ret operator()(Args &&...args) const {
+        return call<Ret>(*this, std::forward<Args>(args)...);
+    }
+    template<
+         typename ...Args
+        ,typename Ret = typename details::holder_result<
+            typename details::value_at_key<
+                 Map
+                ,typename details::call_key<Map, Args...>::type
+            >::type
+        >::type
+    >
+    Ret operator()(Args &&...args) {
+        return call<Ret>(*this, std::forward<Args>(args)...);
+    }
+
+    // the same as `invoke()`, but the callable-elem is selected as the best viable overload
+    // for the call-site arguments by the C++ implicit-conversion ranking, for example
+    // the `int64_t` one for an `int`. the selection is made at compile time, so the call
+    // is the same direct call. no viable or several equally viable ones is an error.
+    template<
+         typename ...Args
+        ,typename Ret = typename details::holder_result<
+            typename details::value_at<
+                 Map
+                ,details::best_viable<Map, Args &&...>::value
+            >::type
+        >::type
+    >
+    Ret invoke_best(Args &&...args) const {
+        return call_best<Ret>(*this, std::forward<Args>(args)...);
+    }
+    template<
+         typename ...Args
+        ,typename Ret = typename details::holder_result<
+            typename details::value_at<
+                 Map
+                ,details::best_viable<Map, Args &&...>::value
+            >::type
+        >::type
+    >
+    Ret invoke_best(Args &&...args) {
+        return call_best<Ret>(*this, std::forward<Args>(args)...);
+    }
+
+    // double dispatch on the dynamic types of `a` and `b`, which must be the bases of the classes
+    // listed in `TypesA` and `TypesB`. `x.dispatch_id()` is the index of the dynamic type of `x`
+    // in its list (see `dispatch_id_of`). for every pair of the classes the best viable
+    // callable-elem is selected at compile time, as by `invoke_best()`, into a constexpr table
+    // of thunks, so a call is two id loads and one indirect call, the downcasts are static.
+    // throws `std::out_of_range` for the unknown id, and `std::invalid_argument`
+    // for the pair of the classes no callable-elem accepts.
+    template<
+         typename TypesA
+        ,typename TypesB = TypesA
+        ,typename A
+        ,typename B
+        ,typename Ret = typename details::holder_result<
+            typename details::value_at<Map, 0>::type
+        >::type
+    >
+    Ret dispatch(A &a, B &b) const {
+        return dispatch_impl<Ret, TypesA, TypesB>(
+             details::make_index_sequence<
+                details::list_size<TypesA>::value * details::list_size<TypesB>::value
+            >{}
+            ,*this
+            ,a
+            ,b
+        );
+    }
+    template<
+         typename TypesA
+        ,typename TypesB = TypesA
+        ,typename A
+        ,typename B
+        ,typename Ret = typename details::holder_result<
+            typename details::value_at<Map, 0>::type
+        >::type
+    >
+    Ret dispatch(A &a, B &b) {
+        return dispatch_impl<Ret, TypesA, TypesB>(
+             details::make_index_sequence<
+                details::list_size<TypesA>::value * details::list_size<TypesB>::value
+            >{}
+            ,*this
+            ,a
+            ,b
+        );
+    }
+
+    // the overloaded_function with the callable-elems of this one followed by `funcs`.
+    // the existing holders are copied (moved out of the r-value) as is, without re-wrapping.
+    // the signatures must not repeat, and the policy is not carried over, see `merge()`
+    template<typename... Funcs>
+    typename details::spliced_function<
+         details::merge_map
+        ,Map
+        ,typename details::map_generator<Funcs...>::type
+    >::type extend(Funcs &&...funcs) const & {
+        return details::splice<details::merge_map>(
+             *this
+            ,overloaded_function<typename details::map_generator<Funcs...>::type>{
+                 details::construct_tag{}
+                ,std::forward<Funcs>(funcs)...
+            }
+        );
+    }
+    template<typename... Funcs>
+    typename details::spliced_function<
+         details::merge_map
+        ,Map
+        ,typename details::map_generator<Funcs...>::type
+    >::type extend(Funcs &&...funcs) && {
+        return details::splice<details::merge_map>(
+             std::move(*this)
+            ,overloaded_function<typename details::map_generator<Funcs...>::type>{
+                 details::construct_tag{}
+                ,std::forward<Funcs>(funcs)...
+            }
+        );
+    }
+    // the same, but `funcs` override the callable-elems with the same signatures
+    template<typename... Funcs>
+    typename details::spliced_function<
+         details::override_map
+        ,Map
+        ,typename details::map_generator<Funcs...>::type
+    >::type extend_override(Funcs &&...funcs) const & {
+        return details::splice<details::override_map>(
+             *this
+            ,overloaded_function<typename details::map_generator<Funcs...>::type>{
+                 details::construct_tag{}
+                ,std::forward<Funcs>(funcs)...
+            }
+        );
+    }
+    template<typename... Funcs>
+    typename details::spliced_function<
+         details::override_map
+        ,Map
+        ,typename details::map_generator<Funcs...>::type
+    >::type extend_override(Funcs &&...funcs) && {
+        return details::splice<details::override_map>(
+             std::move(*this)
+            ,overloaded_function<typename details::map_generator<Funcs...>::type>{
+                 details::construct_tag{}
+                ,std::forward<Funcs>(funcs)...
+            }
+        );
+    }
+
+    // calls every callable-elem with the call-site parameters, in the order they were
+    // passed to `make_multi()`. the sequence of the calls is unrolled at compile time.
+    // the arguments are shared by the calls, so they are passed as l-values.
+    // the results are discarded.
+    template<typename ...Args>
+    void broadcast(Args &&...args) const {
+        broadcast_impl(*this, args...);
+    }
+    template<typename ...Args>
+    void broadcast(Args &&...args) {
+        broadcast_impl(*this, args...);
+    }
+
+    // calls the `idx`-th callable-elem through a constexpr table of thunks.
+    // every callable-elem must accept `args...`, or an empty tag followed by `args...`,
+    // in which case the tag is default-constructed. throws `std::out_of_range`.
+    template<
+         typename ...Args
+        ,typename Ret = typename details::holder_result<
+            typename details::value_at<Map, 0>::type
+        >::type
+    >
+    Ret invoke_by_index(std::size_t idx, Args &&...args) const {
+        return invoke_by_index_impl<Ret>(
+             *this
+            ,details::make_index_sequence<details::map_size<Map>::value>{}
+            ,idx
+            ,std::forward<Args>(args)...
+        );
+    }
+    template<
+         typename ...Args
+        ,typename Ret = typename details::holder_result<
+            typename details::value_at<Map, 0>::type
+        >::type
+    >
+    Ret invoke_by_index(std::size_t idx, Args &&...args) {
+        return invoke_by_index_impl<Ret>(
+             *this
+            ,details::make_index_sequence<details::map_size<Map>::value>{}
+            ,idx
+            ,std::forward<Args>(args)...
+        );
+    }
+
+    // calls the callable-elem selected by the element type of `range` for every element,
+    // and writes the results to `out`. the callable-elem is selected once, so the loop
+    // is free of the dispatch and can be unrolled and vectorized.
+    // returns the output iterator past the last written result.
+    template<
+         typename Range
+        ,typename OutputIterator
+        ,typename = typename std::enable_if<
+            !is_zipped_ranges<typename std::decay<Range>::type>::value
+        >::type
+    >
+    OutputIterator invoke_each(Range &&range, OutputIterator out) const {
+        return invoke_each_impl(*this, std::forward<Range>(range), out);
+    }
+    template<
+         typename Range
+        ,typename OutputIterator
+        ,typename = typename std::enable_if<
+            !is_zipped_ranges<typename std::decay<Range>::type>::value
+        >::type
+    >
+    OutputIterator invoke_each(Range &&range, OutputIterator out) {
+        return invoke_each_impl(*this, std::forward<Range>(range), out);
+    }
+    // the same for the `zip()`-ed ranges of the random access iterators.
+    // the elements are passed as the arguments, and the shortest range defines the length.
+    template<typename... Ranges, typename OutputIterator>
+    OutputIterator invoke_each(const zipped_ranges<Ranges...> &zipped, OutputIterator out) const {
+        return invoke_each_zipped(
+             *this
+            ,zipped
+            ,out
+            ,details::make_index_sequence<sizeof...(Ranges)>{}
+        );
+    }
+    template<typename... Ranges, typename OutputIterator>
+    OutputIterator invoke_each(const zipped_ranges<Ranges...> &zipped, OutputIterator out) {
+        return invoke_each_zipped(
+             *this
+            ,zipped
+            ,out
+            ,details::make_index_sequence<sizeof...(Ranges)>{}
+        );
+    }
+    // the same, but the results are discarded
+    template<typename Range>
+    void invoke_each(Range &&range) const {
+        invoke_each(std::forward<Range>(range), details::discard_output{});
+    }
+    template<typename Range>
+    void invoke_each(Range &&range) {
+        invoke_each(std::forward<Range>(range), details::discard_output{});
+    }
+
+#if __cplusplus >= 201703L
+    // calls the callable-elem for the active alternative of `std::variant`
+    // through a table of thunks derived from the stored signatures.
+    // throws `std::bad_variant_access` for the valueless variant.
+    template<typename Variant>
+    decltype(auto) visit(Variant &&v) const {
+        return visit_impl(*this, std::forward<Variant>(v));
+    }
+    template<typename Variant>
+    decltype(auto) visit(Variant &&v) {
+        return visit_impl(*this, std::forward<Variant>(v));
+    }
+
+    // calls the callable-elem for every element of the `std::variant` range.
+    // the elements are partitioned by the alternative once (a counting sort of their
+    // addresses), then each group is passed to its callable-elem in a tight loop.
+    // the order is kept within a group. valueless elements are skipped.
+    // the calls are made the same way as by `visit()`.
+    template<typename Iterator>
+    void visit_all(Iterator first, Iterator last) const {
+        visit_all_impl(*this, first, last);
+    }
+    template<typename Iterator>
+    void visit_all(Iterator first, Iterator last) {
+        visit_all_impl(*this, first, last);
+    }
+    template<typename Range>
+    void visit_all(Range &&range) const {
+        using std::begin;
+        using std::end;
+
+        visit_all_impl(*this, begin(range), end(range));
+    }
+    template<typename Range>
+    void visit_all(Range &&range) {
+        using std::begin;
+        using std::end;
+
+        visit_all_impl(*this, begin(range), end(range));
+    }
+#endif // __cplusplus >= 201703L
+
+private:
+    template<typename, typename>
+    friend struct overloaded_function;
+
+    template<typename Ret, typename Self, typename... Args>
+    static Ret call(Self &self, Args &&...args) {
+        using types = typename details::call_key<Map, Args...>::type;
+        static_assert(
+             !std::is_same<types, details::ambiguous_call_key>::value
+            ,"the call is ambiguous: several callable-elems equally match the value categories of the arguments"
+        );
+        static_assert(
+             details::has_key<Map, types>::value
+            ,"calls-map doesn't contains callable-elem with specified parameters"
+        );
+
+        return call_slot<Ret, typename details::slot_of_key<Map, types>::type>(
+             std::is_same<Policy, no_policy>{}
+            ,self
+            ,std::forward<Args>(args)...
+        );
+    }
+
+    template<typename Ret, std::size_t I, typename Self, typename... Args>
+    static Ret call_at(Self &self, Args &&...args) {
+        return call_slot<Ret, typename details::slot_of_index<Map, I>::type>(
+             std::is_same<Policy, no_policy>{}
+            ,self
+            ,std::forward<Args>(args)...
+        );
+    }
+
+    // the slot is reached by its type, without a lookup.
+    // `no_policy` has nothing to do around the call, so its scope isn't instantiated.
+    template<typename Ret, typename Slot, typename Self, typename... Args>
+    static Ret call_slot(std::true_type, Self &self, Args &&...args) {
+        static_assert(
+             details::is_callable_through<Self, typename Slot::holder_type, Args &&...>::value
+            ,"the callable-elem is mutable, call it through a non-const overloaded_function"
+        );
+
+        return static_cast<typename details::copy_const<Self, typename Slot::slot_type>::type &>(
+            self.map()
+        ).get()(std::forward<Args>(args)...);
+    }
+    template<typename Ret, typename Slot, typename Self, typename... Args>
+    static Ret call_slot(std::false_type, Self &self, Args &&...args) {
+        static_assert(
+             details::is_callable_through<Self, typename Slot::holder_type, Args &&...>::value
+            ,"the callable-elem is mutable, call it through a non-const overloaded_function"
+        );
+
+        typename Policy::template scope<Map, Slot::index> scope{self.policy(), args...};
+
+        return static_cast<typename details::copy_const<Self, typename Slot::slot_type>::type &>(
+            self.map()
+        ).get()(std::forward<Args>(args)...);
+    }
+
+    template<typename Ret, typename Self, typename... Args>
+    static Ret call_best(Self &self, Args &&...args) {
+        using best = details::best_viable<Map, Args &&...>;
+        static_assert(
+             best::found || best::ambiguous
+            ,"calls-map doesn't contains callable-elem viable for specified parameters"
+        );
+        static_assert(
+             !best::ambiguous
+            ,"the call is ambiguous: several callable-elems are equally viable for specified parameters"
+        );
+
+        return call_at<Ret, best::value>(self, std::forward<Args>(args)...);
+    }
+
+    template<
+         typename Ret
+        ,typename TypesA
+        ,typename TypesB
+        ,typename Self
+        ,typename A
+        ,typename B
+        ,std::size_t... Ks
+    >
+    static Ret dispatch_impl(details::index_sequence<Ks...>, Self &self, A &a, B &b) {
+        enum: std::size_t {
+             rows = details::list_size<TypesA>::value
+            ,cols = details::list_size<TypesB>::value
+        };
+        using thunk_type = Ret(*)(Self &, A &, B &);
+        static constexpr thunk_type table[] = {
+            &dispatch_thunk<
+                 Ret
+                ,typename details::copy_const<A, typename details::type_at<Ks / cols, TypesA>::type>::type
+                ,typename details::copy_const<B, typename details::type_at<Ks % cols, TypesB>::type>::type
+            >...
+        };
+
+        const std::size_t ia = a.dispatch_id();
+        const std::size_t ib = b.dispatch_id();
+        if ( ia >= rows || ib >= cols ) {
+            throw std::out_of_range("overloaded_function::dispatch(): dispatch id is out of range");
+        }
+
+        return table[ia * cols + ib](self, a, b);
+    }
+
+    template<typename Ret, typename DA, typename DB, typename Self, typename A, typename B>
+    static Ret dispatch_thunk(Self &self, A &a, B &b) {
+        using best = details::best_viable<Map, DA &, DB &>;
+        static_assert(
+             !best::ambiguous
+            ,"the dispatch is ambiguous: several callable-elems are equally viable for the classes"
+        );
+
+        return dispatch_cell<Ret, best::value>(
+             std::integral_constant<bool, best::found>{}
+            ,self
+            ,static_cast<DA &>(a)
+            ,static_cast<DB &>(b)
+        );
+    }
+
+    template<typename Ret, std::size_t I, typename Self, typename DA, typename DB>
+    static Ret dispatch_cell(std::true_type, Self &self, DA &a, DB &b) {
+        return call_at<Ret, I>(self, a, b);
+    }
+    template<typename Ret, std::size_t I, typename Self, typename DA, typename DB>
+    static Ret dispatch_cell(std::false_type, Self &, DA &, DB &) {
+        throw std::invalid_argument("overloaded_function::dispatch(): no callable-elem for the classes");
+    }
+
+    // calls the `I`-th callable-elem of `self` through `call_at()`, so through the policy.
+    // passed as the callable to the helpers calling the slot known at compile time.
+    template<std::size_t I, typename Self>
+    struct slot_caller {
+        using result_type = typename details::holder_result<
+            typename details::value_at<Map, I>::type
+        >::type;
+
+        template<typename... Args>
+        result_type operator()(Args &&...args) const {
+            return call_at<result_type, I>(self, std::forward<Args>(args)...);
+        }
+
+        Self &self;
+    };
+
+    template<typename Self, typename... Args>
+    static void broadcast_impl(Self &self, Args &...args) {
+        using types = typename details::call_key<Map, Args &...>::type;
+        static_assert(
+             details::key_count<types, typename Map::keys>::value != 0
+            ,"calls-map doesn't contains callable-elem with specified parameters"
+        );
+
+        broadcast_slots<types>(
+             self
+            ,details::make_index_sequence<details::map_size<Map>::value>{}
+            ,args...
+        );
+    }
+
+    template<typename Key, typename Self, std::size_t... Is, typename... Args>
+    static void broadcast_slots(Self &self, details::index_sequence<Is...>, Args &...args) {
+        using swallow = int[];
+        (void)swallow{0, (broadcast_slot<Is>(
+             std::is_same<Key, typename details::key_at<Map, Is>::type>{}
+            ,self
+            ,args...
+        ), 0)...};
+    }
+
+    template<std::size_t I, typename Self, typename... Args>
+    static void broadcast_slot(std::true_type, Self &self, Args &...args) {
+        slot_caller<I, Self>{self}(args...);
+    }
+    template<std::size_t I, typename Self, typename... Args>
+    static void broadcast_slot(std::false_type, Self &, Args &...) {}
+
+    template<std::size_t I, typename Ret, typename Self, typename... Args>
+    static Ret index_thunk(Self &self, Args &&...args) {
+        using caller = details::index_caller<
+            typename details::index_call_tag<
+                 typename details::key_at<Map, I>::type
+                ,typename details::transform_parameters<Args...>::type
+            >::type
+        >;
+
+        return caller::template apply<Ret>(slot_caller<I, Self>{self}, std::forward<Args>(args)...);
+    }
+
+    template<typename Ret, typename Self, std::size_t... Is, typename... Args>
+    static Ret invoke_by_index_impl(Self &self, details::index_sequence<Is...>, std::size_t idx, Args &&...args) {
+        using thunk_type = Ret(*)(Self &, Args &&...);
+        static constexpr thunk_type table[] = {&index_thunk<Is, Ret, Self, Args...>...};
+
+        if ( idx >= sizeof...(Is) ) {
+            throw std::out_of_range("overloaded_function::invoke_by_index(): index is out of range");
+        }
+
+        return table[idx](self, std::forward<Args>(args)...);
+    }
+
+    template<typename Self, typename Range, typename OutputIterator>
+    static OutputIterator invoke_each_impl(Self &self, Range &&range, OutputIterator out) {
+        using std::begin;
+        using std::end;
+
+        auto first = begin(range);
+        auto last = end(range);
+        using types = typename details::transform_parameters<decltype(*first)>::type;
+        static_assert(
+             details::has_key<Map, types>::value
+            ,"calls-map doesn't contains callable-elem with specified parameters"
+        );
+
+        slot_caller<details::index_of_key<Map, types>::value, Self> f{self};
+        for ( ; first != last; ++first ) {
+            details::call_and_store(f, out, *first);
+        }
+
+        return out;
+    }
+
+    template<typename Self, typename... Ranges, typename OutputIterator, std::size_t... Is>
+    static OutputIterator invoke_each_zipped(
+         Self &self
+        ,const zipped_ranges<Ranges...> &zipped
+        ,OutputIterator out
+        ,details::index_sequence<Is...>)
+    {
+        using std::begin;
+        using std::end;
+
+        static_assert(
+             details::all_of<
+                std::is_base_of<
+                     std::random_access_iterator_tag
+                    ,typename std::iterator_traits<
+                        decltype(begin(std::get<Is>(zipped.ranges)))
+                    >::iterator_category
+                >::value...
+             >::value
+            ,"only the ranges of random access iterators can be zipped"
+        );
+
+        auto firsts = std::make_tuple(begin(std::get<Is>(zipped.ranges))...);
+        auto size = std::min({
+            static_cast<std::size_t>(
+                std::distance(std::get<Is>(firsts), end(std::get<Is>(zipped.ranges)))
+            )...
+        });
+
+        using types = typename details::transform_parameters<
+            decltype(*std::get<Is>(firsts))...
+        >::type;
+        static_assert(
+             details::has_key<Map, types>::value
+            ,"calls-map doesn't contains callable-elem with specified parameters"
+        );
+
+        slot_caller<details::index_of_key<Map, types>::value, Self> f{self};
+        for ( std::size_t i = 0; i < size; ++i ) {
+            details::call_and_store(f, out, std::get<Is>(firsts)[i]...);
+        }
+
+        return out;
+    }
+
+#if __cplusplus >= 201703L
+    template<std::size_t I, typename Variant>
+    using variant_alternative_ref = std::conditional_t<
+         std::is_lvalue_reference_v<Variant>
+        ,std::variant_alternative_t<I, std::remove_reference_t<Variant>> &
+        ,std::variant_alternative_t<I, std::remove_reference_t<Variant>> &&
+    >;
+
+    template<std::size_t I, typename Ret, typename Self, typename Variant>
+    static Ret visit_thunk(Self &self, Variant &&v) {
+        return self(static_cast<variant_alternative_ref<I, Variant>>(*std::get_if<I>(&v)));
+    }
+
+    template<typename Self, typename Variant>
+    static decltype(auto) visit_impl(Self &self, Variant &&v) {
+        using variant_type = std::remove_cv_t<std::remove_reference_t<Variant>>;
+
+        return visit_table<Self, Variant>(
+             self
+            ,std::forward<Variant>(v)
+            ,std::make_index_sequence<std::variant_size_v<variant_type>>{}
+        );
+    }
+
+    template<typename Self, typename Variant, std::size_t... Is>
+    static decltype(auto) visit_table(Self &self, Variant &&v, std::index_sequence<Is...>) {
+        using Ret = decltype(self(std::declval<variant_alternative_ref<0, Variant>>()));
+        static_assert(
+             (std::is_same_v<Ret, decltype(self(std::declval<variant_alternative_ref<Is, Variant>>()))> && ...)
+            ,"callable-elems for all the variant alternatives must have the same result type"
+        );
+
+        using thunk_type = Ret(*)(Self &, Variant &&);
+        static constexpr thunk_type table[] = {&visit_thunk<Is, Ret, Self, Variant>...};
+
+        std::size_t idx = v.index();
+        if ( idx >= sizeof...(Is) ) {
+            throw std::bad_variant_access{};
+        }
+
+        return table[idx](self, std::forward<Variant>(v));
+    }
+
+    template<std::size_t I, typename Self, typename Pointer>
+    static void visit_all_group(Self &self, const Pointer *first, const Pointer *last) {
+        using alternative_ref = variant_alternative_ref<I, decltype(**first)>;
+        using types = typename details::call_key<Map, alternative_ref>::type;
+        static_assert(
+             details::has_key<Map, types>::value
+            ,"calls-map doesn't contains callable-elem for the variant alternative"
+        );
+        enum: std::size_t { index = details::index_of_key<Map, types>::value };
+        using Ret = typename details::holder_result<typename details::value_at<Map, index>::type>::type;
+
+        for ( ; first != last; ++first ) {
+            call_at<Ret, index>(self, static_cast<alternative_ref>(*std::get_if<I>(*first)));
+        }
+    }
+
+    template<typename Self, typename Iterator>
+    static void visit_all_impl(Self &self, Iterator first, Iterator last) {
+        using variant_type = std::remove_cv_t<std::remove_reference_t<decltype(*first)>>;
+
+        visit_all_groups(
+             self
+            ,first
+            ,last
+            ,std::make_index_sequence<std::variant_size_v<variant_type>>{}
+        );
+    }
+
+    template<typename Self, typename Iterator, std::size_t... Is>
+    static void visit_all_groups(Self &self, Iterator first, Iterator last, std::index_sequence<Is...>) {
+        using pointer = decltype(&*first);
+        enum: std::size_t { alternatives = sizeof...(Is) };
+
+        // the group of the alternative `i` is `[offsets[i], offsets[i+1])`
+        std::size_t offsets[alternatives + 1] = {};
+        for ( auto it = first; it != last; ++it ) {
+            if ( !it->valueless_by_exception() ) {
+                ++offsets[it->index() + 1];
+            }
+        }
+        for ( std::size_t i = 0; i < alternatives; ++i ) {
+            offsets[i+1] += offsets[i];
+        }
+
+        std::vector<pointer> order(offsets[alternatives]);
+        std::size_t next[alternatives] = {offsets[Is]...};
+        for ( ; first != last; ++first ) {
+            if ( !first->valueless_by_exception() ) {
+                order[next[first->index()]++] = &*first;
+            }
+        }
+
+        const pointer *groups = order.data();
+        (visit_all_group<Is>(self, groups + offsets[Is], groups + offsets[Is+1]), ...);
+    }
+#endif // __cplusplus >= 201703L
+
+    using storage_type = details::slot_storage<Map>;
+    using policy_storage_type = details::slot_storage<Policy>;
+
+    Map& map() { return storage_type::get(); }
+    const Map& map() const { return storage_type::get(); }
+};
+
+/*************************************************************************************************/
+
+template<typename ...Funcs>
+struct make_overloaded {
+    using type = overloaded_function<typename details::map_generator<Funcs...>::type>;
+
+    // the same calls-map with the specified policy, see `no_policy`
+    template<typename Policy>
+    using with_policy = overloaded_function<typename details::map_generator<Funcs...>::type, Policy>;
+};
+
+/*************************************************************************************************/
+
+// the same as `make_overloaded`, but with the value-category preserving keys, see `make_exact()`
+template<typename ...Funcs>
+struct make_overloaded_exact {
+    using type = overloaded_function<typename details::exact_map_generator<Funcs...>::type>;
+};
+
+/*************************************************************************************************/
+
+// the same as `make_overloaded`, but several callable-elems may share a signature, see `make_multi()`
+template<typename ...Funcs>
+struct make_overloaded_multi {
+    using type = overloaded_function<typename details::multi_map_generator<Funcs...>::type>;
+};
+
+/*************************************************************************************************/
+
+template<std::size_t Capacity, typename ...Funcs>
+struct make_overloaded_inplace {
+    using type = overloaded_function<
+        typename details::map_generator<
+            inplace_function<
+                 typename details::callable_signature<Funcs>::signature
+                ,Capacity
+            >...
+        >::type
+    >;
+};
+
+/*************************************************************************************************/
+
+template<
+     typename... Funcs
+    ,typename FuncsMap = typename details::map_generator<Funcs...>::type
+>
+auto make(Funcs &&...funcs) -> overloaded_function<FuncsMap> {
+    return overloaded_function<FuncsMap>{details::construct_tag{}, std::forward<Funcs>(funcs)...};
+}
+
+/*************************************************************************************************/
+
+// the same as `make()`, but the rvalue-ref parameters are not decayed in the keys,
+// so `f(const T &)` and `f(T &&)` can coexist, and an r-value argument selects the `&&` one.
+template<
+     typename... Funcs
+    ,typename FuncsMap = typename details::exact_map_generator<Funcs...>::type
+>
+auto make_exact(Funcs &&...funcs) -> overloaded_function<FuncsMap> {
+    return overloaded_function<FuncsMap>{details::construct_tag{}, std::forward<Funcs>(funcs)...};
+}
+
+/*************************************************************************************************/
+
+// the same as `make()`, but several callable-elems may share a signature.
+// all of them are called by `broadcast()`, in the order they are passed here;
+// `invoke()` is available only for the signatures with a single callable-elem.
+template<
+     typename... Funcs
+    ,typename FuncsMap = typename details::multi_map_generator<Funcs...>::type
+>
+auto make_multi(Funcs &&...funcs) -> overloaded_function<FuncsMap> {
+    return overloaded_function<FuncsMap>{details::construct_tag{}, std::forward<Funcs>(funcs)...};
+}
+
+/*************************************************************************************************/
+
+// the overloaded_function with the callable-elems of `l` followed by the ones of `r`.
+// the holders are copied (moved out of the r-values) as is, so no call layer is added.
+// the signatures must not repeat. the policies are not carried over, because the
+// slots get the new indices, use `with_policy()` for the result.
+template<
+     typename L
+    ,typename R
+    ,typename Spliced = details::spliced_function<
+         details::merge_map
+        ,typename std::decay<L>::type::map_type
+        ,typename std::decay<R>::type::map_type
+    >
+>
+typename Spliced::type merge(L &&l, R &&r) {
+    return details::splice<details::merge_map>(std::forward<L>(l), std::forward<R>(r));
+}
+
+// the same, but the callable-elems of `r` override the ones of `l` with the same signatures
+template<
+     typename L
+    ,typename R
+    ,typename Spliced = details::spliced_function<
+         details::override_map
+        ,typename std::decay<L>::type::map_type
+        ,typename std::decay<R>::type::map_type
+    >
+>
+typename Spliced::type merge_override(L &&l, R &&r) {
+    return details::splice<details::override_map>(std::forward<L>(l), std::forward<R>(r));
+}
+
+/*************************************************************************************************/
+
+// the overloaded_function with the same callable-elems and the specified policy
+template<
+     typename Policy
+    ,typename Overloaded
+    ,typename Decayed = typename std::decay<Overloaded>::type
+>
+auto with_policy(Overloaded &&o, Policy policy)
+    -> overloaded_function<typename Decayed::map_type, Policy>
+{
+    return overloaded_function<typename Decayed::map_type, Policy>{
+         std::forward<Overloaded>(o)
+        ,std::move(policy)
+    };
 }
 
 /*************************************************************************************************/
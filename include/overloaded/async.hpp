@@ -0,0 +1,314 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __OVERLOADED_ASYNC_HPP
+#define __OVERLOADED_ASYNC_HPP
+
+#include <overloaded.hpp>
+#include <overloaded/bucketed_queue.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace overloaded {
+namespace details {
+
+/*************************************************************************************************/
+// the bounded lock-free ring with many producers and many consumers.
+// every cell carries a sequence number telling whether it's free for the producer
+// of the position or filled for the consumer of the position (D.Vyukov's bounded queue).
+
+enum: std::size_t { cache_line_size = 64 };
+
+template<typename T, std::size_t Capacity>
+struct mpmc_ring {
+    static_assert(
+         Capacity != 0 && (Capacity & (Capacity-1)) == 0
+        ,"the capacity of the ring must be a power of two"
+    );
+
+    mpmc_ring() {
+        for ( std::size_t i = 0; i < Capacity; ++i ) {
+            cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+    ~mpmc_ring() {
+        while ( try_pop([](T &) {}) ) {}
+    }
+
+    mpmc_ring(const mpmc_ring &) = delete;
+    mpmc_ring& operator= (const mpmc_ring &) = delete;
+
+    // returns false when the ring is full, `args` are not touched in this case
+    template<typename... Args>
+    bool try_push(Args &&...args) {
+        std::size_t pos = tail.load(std::memory_order_relaxed);
+        cell *c;
+        for ( ;; ) {
+            c = &cells[pos & (Capacity-1)];
+            std::size_t seq = c->seq.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if ( diff == 0 ) {
+                if ( tail.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed) ) {
+                    break;
+                }
+            } else if ( diff < 0 ) {
+                return false;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        ::new(static_cast<void *>(c->storage)) T(std::forward<Args>(args)...);
+        c->seq.store(pos+1, std::memory_order_release);
+
+        return true;
+    }
+
+    // calls `f` for the oldest element, if any
+    template<typename F>
+    bool try_pop(F &&f) {
+        std::size_t pos = head.load(std::memory_order_relaxed);
+        cell *c;
+        for ( ;; ) {
+            c = &cells[pos & (Capacity-1)];
+            std::size_t seq = c->seq.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos+1);
+            if ( diff == 0 ) {
+                if ( head.compare_exchange_weak(pos, pos+1, std::memory_order_relaxed) ) {
+                    break;
+                }
+            } else if ( diff < 0 ) {
+                return false;
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+
+        T *v = reinterpret_cast<T *>(c->storage);
+        f(*v);
+        v->~T();
+        c->seq.store(pos+Capacity, std::memory_order_release);
+
+        return true;
+    }
+
+private:
+    struct cell {
+        std::atomic<std::size_t> seq;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    // the producers' and the consumers' positions are kept on the different cache lines
+    std::atomic<std::size_t> tail{0};
+    char tail_pad[cache_line_size - sizeof(std::atomic<std::size_t>)];
+    std::atomic<std::size_t> head{0};
+    char head_pad[cache_line_size - sizeof(std::atomic<std::size_t>)];
+    cell cells[Capacity];
+};
+
+/*************************************************************************************************/
+// the ring element is the tuple of the decayed call-site parameters,
+// passed to the callable-elem by `tuple_caller`.
+
+template<typename Keys, std::size_t Capacity>
+struct async_rings;
+
+template<typename... Keys, std::size_t Capacity>
+struct async_rings<type_list<Keys...>, Capacity> {
+    using type = std::tuple<
+        mpmc_ring<
+             typename call_tuple<typename bucket_columns<Keys>::type>::type
+            ,Capacity
+        >...
+    >;
+};
+
+/*************************************************************************************************/
+
+} // ns details
+
+/*************************************************************************************************/
+// runs the calls of an overloaded_function on a pool of worker threads.
+//
+// `post(args...)` moves or copies the arguments into the bounded lock-free ring of the
+// callable-elem, selected at compile time in the same way as `operator()` does.
+// the workers poll the rings and yield when they are empty. the callable-elems must not throw.
+//
+// `async_mode::ordered`: the ring of the `I`-th callable-elem is drained by the worker
+// `I % workers`, so every callable-elem is called from a single thread and keeps the post
+// order. the number of workers is limited by the number of the callable-elems, so a single
+// hot callable-elem is served by a single worker.
+// `async_mode::shared`: every worker drains every ring, so the calls of a callable-elem
+// are spread over all the workers, concurrently and not in the post order.
+
+enum class async_mode { ordered, shared };
+
+template<typename Overloaded, std::size_t Capacity = 1024>
+struct async_dispatcher;
+
+template<typename Map, typename Policy, std::size_t Capacity>
+struct async_dispatcher<overloaded_function<Map, Policy>, Capacity> {
+    using overloaded_type = overloaded_function<Map, Policy>;
+
+    explicit async_dispatcher(
+         overloaded_type o
+        ,std::size_t workers = 1
+        ,async_mode mode = async_mode::ordered
+    )
+        :o{std::move(o)}
+        ,rings{new rings_type}
+        ,shared{mode == async_mode::shared}
+        ,stopping{false}
+    {
+        std::size_t n = workers == 0 ? 1 : workers;
+        if ( !shared ) {
+            n = n < details::map_size<Map>::value ? n : details::map_size<Map>::value;
+        }
+        for ( std::size_t i = 0; i < n; ++i ) {
+            threads.emplace_back([this, i, n] { work(i, n); });
+        }
+    }
+    ~async_dispatcher() {
+        stop();
+    }
+
+    async_dispatcher(const async_dispatcher &) = delete;
+    async_dispatcher& operator= (const async_dispatcher &) = delete;
+
+    // returns false when the ring of the callable-elem is full, or the dispatcher is stopped
+    template<typename ...Args>
+    bool try_post(Args &&...args) {
+        using types = typename details::call_key<Map, Args...>::type;
+        static_assert(
+             details::has_key<Map, types>::value
+            ,"calls-map doesn't contains callable-elem with specified parameters"
+        );
+
+        if ( stopping.load(std::memory_order_acquire) ) {
+            return false;
+        }
+
+        return std::get<details::index_of_key<Map, types>::value>(*rings)
+            .try_push(std::forward<Args>(args)...);
+    }
+    // yields while the ring of the callable-elem is full.
+    // returns false once the dispatcher is stopped
+    template<typename ...Args>
+    bool post(Args &&...args) {
+        while ( !try_post(std::forward<Args>(args)...) ) {
+            if ( stopping.load(std::memory_order_acquire) ) {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+
+        return true;
+    }
+
+    // waits for the calls posted before, and stops the workers.
+    // the calls posted concurrently with `stop()` may be dropped
+    void stop() {
+        stopping.store(true, std::memory_order_release);
+        for ( auto &t: threads ) {
+            t.join();
+        }
+        threads.clear();
+    }
+
+    std::size_t workers() const { return threads.size(); }
+
+private:
+    using rings_type = typename details::async_rings<
+         typename Map::keys
+        ,Capacity
+    >::type;
+    using swallow = int[];
+
+    void work(std::size_t worker, std::size_t workers) {
+        for ( ;; ) {
+            if ( drain(worker, workers) ) {
+                continue;
+            }
+            if ( stopping.load(std::memory_order_acquire) ) {
+                while ( drain(worker, workers) ) {}
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    // returns the number of the calls made
+    std::size_t drain(std::size_t worker, std::size_t workers) {
+        return drain_impl(
+             worker
+            ,workers
+            ,details::make_index_sequence<details::map_size<Map>::value>{}
+        );
+    }
+    template<std::size_t... Is>
+    std::size_t drain_impl(std::size_t worker, std::size_t workers, details::index_sequence<Is...>) {
+        std::size_t calls = 0;
+        (void)swallow{0, (calls += (shared || Is % workers == worker ? drain_ring<Is>() : 0), 0)...};
+
+        return calls;
+    }
+    template<std::size_t I>
+    std::size_t drain_ring() {
+        using tuple_type = typename details::call_tuple<
+            typename details::bucket_columns<typename details::key_at<Map, I>::type>::type
+        >::type;
+        using caller = details::tuple_caller<
+             tuple_type
+            ,typename details::signature_params<
+                typename details::holder_signature<typename details::value_at<Map, I>::type>::type
+             >::type
+        >;
+
+        const overloaded_type &f = o;
+        std::size_t calls = 0;
+        while ( std::get<I>(*rings).try_pop([&f](tuple_type &t) { caller::apply(f, t); }) ) {
+            ++calls;
+        }
+
+        return calls;
+    }
+
+    overloaded_type o;
+    std::unique_ptr<rings_type> rings;
+    const bool shared;
+    std::atomic<bool> stopping;
+    std::vector<std::thread> threads;
+};
+
+/*************************************************************************************************/
+
+} // ns overloaded
+
+#endif // __OVERLOADED_ASYNC_HPP
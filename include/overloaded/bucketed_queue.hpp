@@ -0,0 +1,255 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __OVERLOADED_BUCKETED_QUEUE_HPP
+#define __OVERLOADED_BUCKETED_QUEUE_HPP
+
+#include <overloaded.hpp>
+
+#include <tuple>
+#include <vector>
+
+namespace overloaded {
+namespace details {
+
+/*************************************************************************************************/
+// one structure-of-arrays bucket per signature: a column per parameter.
+// the column element is passed to the callable-elem as l-value only when it takes
+// it by the non-const l-value ref, otherwise it's moved.
+
+template<typename Column, typename Param>
+struct column_ref {
+    using type = typename std::conditional<
+         std::is_lvalue_reference<Param>::value
+            && !std::is_const<typename std::remove_reference<Param>::type>::value
+        ,Column &
+        ,Column &&
+    >::type;
+};
+
+template<typename Columns, typename Params>
+struct soa_bucket;
+
+template<typename... Columns, typename... Params>
+struct soa_bucket<type_list<Columns...>, type_list<Params...>> {
+    template<typename... Args>
+    void push(Args &&...args) {
+        push_impl(make_index_sequence<sizeof...(Columns)>{}, std::forward<Args>(args)...);
+        ++count;
+    }
+
+    // the columns are moved aside before the calls, so a callable-elem can push into
+    // the same bucket: such a call is kept for the next drain. returns the number of the calls.
+    template<typename F>
+    std::size_t drain(const F &f) {
+        return drain_impl(f, make_index_sequence<sizeof...(Columns)>{});
+    }
+
+    void clear() {
+        clear_impl(make_index_sequence<sizeof...(Columns)>{});
+    }
+
+    void reserve(std::size_t n) {
+        reserve_impl(make_index_sequence<sizeof...(Columns)>{}, n);
+    }
+
+    std::size_t count = 0;
+
+private:
+    using swallow = int[];
+
+    template<std::size_t... Is, typename... Args>
+    void push_impl(index_sequence<Is...>, Args &&...args) {
+        (void)swallow{0, (std::get<Is>(columns).emplace_back(std::forward<Args>(args)), 0)...};
+    }
+
+    template<typename F, std::size_t... Is>
+    std::size_t drain_impl(const F &f, index_sequence<Is...>) {
+        std::tuple<std::vector<Columns>...> batch;
+        batch.swap(columns);
+        const std::size_t n = count;
+        count = 0;
+
+        for ( std::size_t i = 0; i < n; ++i ) {
+            f(static_cast<typename column_ref<Columns, Params>::type>(std::get<Is>(batch)[i])...);
+        }
+
+        // keeps the capacity when nothing was pushed during the drain
+        (void)swallow{0, (std::get<Is>(batch).clear(), 0)...};
+        if ( count == 0 ) {
+            batch.swap(columns);
+        }
+
+        return n;
+    }
+
+    template<std::size_t... Is>
+    void clear_impl(index_sequence<Is...>) {
+        (void)swallow{0, (std::get<Is>(columns).clear(), 0)...};
+        count = 0;
+    }
+
+    template<std::size_t... Is>
+    void reserve_impl(index_sequence<Is...>, std::size_t n) {
+        (void)swallow{0, (std::get<Is>(columns).reserve(n), 0)...};
+    }
+
+    std::tuple<std::vector<Columns>...> columns;
+};
+
+// the `make_exact()` keys may contain the rvalue-refs
+template<typename Key>
+struct bucket_columns;
+
+template<typename... Types>
+struct bucket_columns<type_list<Types...>> {
+    using type = type_list<typename std::remove_reference<Types>::type...>;
+};
+
+// the tuple of the bucket columns, for the queues keeping a call as a single element
+template<typename Columns>
+struct call_tuple;
+
+template<typename... Columns>
+struct call_tuple<type_list<Columns...>> {
+    using type = std::tuple<Columns...>;
+};
+
+// calls `f` with the tuple elements, passed in the same way as the bucket columns
+template<typename Tuple, typename Params>
+struct tuple_caller;
+
+template<typename... Columns, typename... Params>
+struct tuple_caller<std::tuple<Columns...>, type_list<Params...>> {
+    template<typename F>
+    static void apply(const F &f, std::tuple<Columns...> &t) {
+        apply_impl(f, t, make_index_sequence<sizeof...(Columns)>{});
+    }
+
+private:
+    template<typename F, std::size_t... Is>
+    static void apply_impl(const F &f, std::tuple<Columns...> &t, index_sequence<Is...>) {
+        f(static_cast<typename column_ref<Columns, Params>::type>(std::get<Is>(t))...);
+    }
+};
+
+template<typename Keys, typename Holders>
+struct bucket_tuple;
+
+template<typename... Keys, typename... Holders>
+struct bucket_tuple<type_list<Keys...>, type_list<Holders...>> {
+    using type = std::tuple<
+        soa_bucket<
+             typename bucket_columns<Keys>::type
+            ,typename signature_params<typename holder_signature<Holders>::type>::type
+        >...
+    >;
+};
+
+/*************************************************************************************************/
+
+} // ns details
+
+/*************************************************************************************************/
+// the queue of the deferred calls to an overloaded_function.
+// `push()` selects the bucket at compile time in the same way as `operator()` does,
+// and `drain()` calls every callable-elem for its bucket, in the slot order,
+// keeping the push order within a bucket. is not thread-safe.
+// a callable-elem may push into the queue being drained: the call pushed into a bucket
+// which is not drained yet by this `drain()` is made by it, the others by the next one.
+
+template<typename Overloaded>
+struct bucketed_queue;
+
+template<typename Map, typename Policy>
+struct bucketed_queue<overloaded_function<Map, Policy>> {
+    using overloaded_type = overloaded_function<Map, Policy>;
+
+    template<typename ...Args>
+    void push(Args &&...args) {
+        using types = typename details::call_key<Map, Args...>::type;
+        static_assert(
+             details::has_key<Map, types>::value
+            ,"calls-map doesn't contains callable-elem with specified parameters"
+        );
+
+        std::get<details::index_of_key<Map, types>::value>(buckets).push(std::forward<Args>(args)...);
+    }
+
+    // returns the number of the calls made
+    std::size_t drain(const overloaded_type &o) {
+        return drain_impl(o, details::make_index_sequence<details::map_size<Map>::value>{});
+    }
+
+    std::size_t size() const {
+        return size_impl(details::make_index_sequence<details::map_size<Map>::value>{});
+    }
+    bool empty() const { return size() == 0; }
+
+    void clear() {
+        clear_impl(details::make_index_sequence<details::map_size<Map>::value>{});
+    }
+    // reserves the space for `n` calls in every bucket
+    void reserve(std::size_t n) {
+        reserve_impl(details::make_index_sequence<details::map_size<Map>::value>{}, n);
+    }
+
+private:
+    using swallow = int[];
+
+    template<std::size_t... Is>
+    std::size_t drain_impl(const overloaded_type &o, details::index_sequence<Is...>) {
+        std::size_t calls = 0;
+        (void)swallow{0, (calls += std::get<Is>(buckets).drain(o), 0)...};
+
+        return calls;
+    }
+    template<std::size_t... Is>
+    std::size_t size_impl(details::index_sequence<Is...>) const {
+        std::size_t res = 0;
+        (void)swallow{0, (res += std::get<Is>(buckets).count, 0)...};
+
+        return res;
+    }
+    template<std::size_t... Is>
+    void clear_impl(details::index_sequence<Is...>) {
+        (void)swallow{0, (std::get<Is>(buckets).clear(), 0)...};
+    }
+    template<std::size_t... Is>
+    void reserve_impl(details::index_sequence<Is...>, std::size_t n) {
+        (void)swallow{0, (std::get<Is>(buckets).reserve(n), 0)...};
+    }
+
+    typename details::bucket_tuple<
+         typename Map::keys
+        ,typename Map::holders
+    >::type buckets;
+};
+
+/*************************************************************************************************/
+
+} // ns overloaded
+
+#endif // __OVERLOADED_BUCKETED_QUEUE_HPP
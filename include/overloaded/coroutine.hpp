@@ -0,0 +1,202 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __OVERLOADED_COROUTINE_HPP
+#define __OVERLOADED_COROUTINE_HPP
+
+#if __cplusplus < 202002L
+#   error "overloaded/coroutine.hpp requires C++20"
+#endif // __cplusplus < 202002L
+
+#include <overloaded.hpp>
+
+#include <coroutine>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace overloaded {
+namespace details {
+
+/*************************************************************************************************/
+
+template<typename T>
+concept has_await_members = requires(T &t) {
+    t.await_ready();
+    t.await_resume();
+};
+
+template<typename T>
+concept has_member_co_await = requires(T &&t) {
+    std::forward<T>(t).operator co_await();
+};
+
+template<typename T>
+concept has_free_co_await = requires(T &&t) {
+    operator co_await(std::forward<T>(t));
+};
+
+template<typename T>
+concept awaitable = has_await_members<T> || has_member_co_await<T> || has_free_co_await<T>;
+
+} // ns details
+
+/*************************************************************************************************/
+// the awaitable which is ready at once, for the callable-elems returning a plain value.
+
+template<typename T>
+struct ready_awaitable {
+    bool await_ready() const noexcept { return true; }
+    void await_suspend(std::coroutine_handle<>) const noexcept {}
+    T await_resume() { return std::forward<T>(value); }
+
+    T value;
+};
+
+template<>
+struct ready_awaitable<void> {
+    bool await_ready() const noexcept { return true; }
+    void await_suspend(std::coroutine_handle<>) const noexcept {}
+    void await_resume() const noexcept {}
+};
+
+/*************************************************************************************************/
+// calls the callable-elem selected by `args...`, and returns an awaitable for its result:
+// the awaitable the callable-elem returned (a `task<T>` for example) as is, or the
+// `ready_awaitable` holding the plain result. `co_invoke()` is not a coroutine itself,
+// so `co_await co_invoke(o, args...)` costs no coroutine frame beyond the callable-elem's.
+
+template<typename Map, typename Policy, typename... Args>
+auto co_invoke(const overloaded_function<Map, Policy> &o, Args &&...args) {
+    using result_type = decltype(o(std::forward<Args>(args)...));
+
+    if constexpr ( details::awaitable<result_type> ) {
+        return o(std::forward<Args>(args)...);
+    } else if constexpr ( std::is_void_v<result_type> ) {
+        o(std::forward<Args>(args)...);
+        return ready_awaitable<void>{};
+    } else {
+        return ready_awaitable<result_type>{o(std::forward<Args>(args)...)};
+    }
+}
+
+/*************************************************************************************************/
+// the per-thread cache of the coroutine frames, by the size classes of `granularity` bytes.
+// a released frame is kept for the next frame of the same class, so the handlers called
+// at a high rate reuse a few frames instead of calling `operator new` per call.
+// the frames bigger than `granularity * classes` bytes are not cached.
+
+struct frame_pool {
+    enum: std::size_t {
+         granularity = 64
+        ,classes = 16
+        ,max_cached_per_class = 64
+    };
+
+    static void* allocate(std::size_t size) {
+        std::size_t cls = size_class(size);
+        if ( cls >= classes ) {
+            return ::operator new(size);
+        }
+
+        free_list &list = lists()[cls];
+        if ( node *n = list.head ) {
+            list.head = n->next;
+            --list.count;
+
+            return n;
+        }
+
+        return ::operator new((cls+1) * granularity);
+    }
+
+    static void deallocate(void *p, std::size_t size) noexcept {
+        std::size_t cls = size_class(size);
+        if ( cls >= classes || lists()[cls].count >= max_cached_per_class ) {
+            ::operator delete(p);
+            return;
+        }
+
+        free_list &list = lists()[cls];
+        list.head = ::new(p) node{list.head};
+        ++list.count;
+    }
+
+    // the number of the frames cached by the calling thread
+    static std::size_t cached() noexcept {
+        std::size_t res = 0;
+        for ( std::size_t i = 0; i < classes; ++i ) {
+            res += lists()[i].count;
+        }
+
+        return res;
+    }
+
+private:
+    struct node {
+        node *next;
+    };
+
+    struct free_list {
+        ~free_list() {
+            while ( head ) {
+                node *next = head->next;
+                ::operator delete(head);
+                head = next;
+            }
+        }
+
+        node *head = nullptr;
+        std::size_t count = 0;
+    };
+
+    static std::size_t size_class(std::size_t size) noexcept {
+        return (size + granularity - 1) / granularity - 1;
+    }
+
+    static free_list* lists() noexcept {
+        thread_local free_list res[classes];
+
+        return res;
+    }
+};
+
+// the base for a `promise_type` to allocate its coroutine frames from `frame_pool`:
+//     struct promise_type: overloaded::pooled_frame { ... };
+struct pooled_frame {
+    static void* operator new(std::size_t size) {
+        return frame_pool::allocate(size);
+    }
+    static void operator delete(void *p, std::size_t size) noexcept {
+        frame_pool::deallocate(p, size);
+    }
+};
+
+/*************************************************************************************************/
+
+} // ns overloaded
+
+#endif // __OVERLOADED_COROUTINE_HPP
@@ -0,0 +1,325 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __OVERLOADED_DYNAMIC_HPP
+#define __OVERLOADED_DYNAMIC_HPP
+
+#include <overloaded.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <typeinfo>
+#include <vector>
+
+namespace overloaded {
+namespace details {
+
+/*************************************************************************************************/
+// the type ids are the FNV-1a hashes of the type names, so they are the same for the
+// same type in every module of the process, including the shared libraries loaded at run time.
+// the hash only selects the slot, the types are equal if their names are.
+
+inline std::uint64_t type_name_hash(const char *name) {
+    std::uint64_t res = 14695981039346656037ull;
+    for ( ; *name; ++name ) {
+        res ^= static_cast<unsigned char>(*name);
+        res *= 1099511628211ull;
+    }
+
+    return res;
+}
+
+struct stable_type {
+    std::uint64_t hash;
+    const char *name;
+
+    // the names of the same type are usually the same pointer within a module
+    bool operator== (const stable_type &r) const {
+        return hash == r.hash && (name == r.name || std::strcmp(name, r.name) == 0);
+    }
+    bool operator!= (const stable_type &r) const { return !(*this == r); }
+};
+
+template<typename T>
+const stable_type& stable_type_id() {
+    static const stable_type id{type_name_hash(typeid(T).name()), typeid(T).name()};
+    return id;
+}
+
+// the signature is identified by its result type and the `callable_signature<>::args` list
+template<typename Ret, typename Args>
+struct dynamic_signature;
+
+template<typename Ret, typename... Args>
+struct dynamic_signature<Ret, type_list<Args...>> {
+    using thunk_type = Ret(*)(void *, const Args &...);
+
+    static const stable_type& id() { return stable_type_id<Ret(Args...)>(); }
+    static const stable_type& args_id() { return stable_type_id<type_list<Args...>>(); }
+
+    template<typename F>
+    static Ret thunk(void *obj, const Args &...args) {
+        return (*static_cast<F *>(obj))(args...);
+    }
+};
+
+// the parameters are passed to the type-erased thunk by const reference,
+// so only the by-value and the by-const-reference ones can be accepted
+template<typename Signature>
+struct const_ref_params;
+
+template<typename Ret, typename... Params>
+struct const_ref_params<Ret(Params...)>: all_of<
+    (!std::is_reference<Params>::value
+        || (std::is_lvalue_reference<Params>::value
+            && std::is_const<typename std::remove_reference<Params>::type>::value))...
+>
+{};
+
+inline std::size_t perfect_hash_slot(std::uint64_t id, std::uint64_t seed, unsigned shift) {
+    return static_cast<std::size_t>(((id ^ seed) * 0x9e3779b97f4a7c15ull) >> shift);
+}
+
+// the splitmix64 sequence of the seeds to try
+inline std::uint64_t perfect_hash_seed(std::uint64_t attempt) {
+    std::uint64_t z = (attempt + 1) * 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+
+    return z ^ (z >> 31);
+}
+
+} // ns details
+
+/*************************************************************************************************/
+// the overload set filled at run time, for example by the plugins loaded at startup.
+// the callables are registered by `add()` with the same keys as in `make()`: the signature
+// must be unique by its parameters. `seal()` ends the registration and builds the perfect
+// hash table, after that `call<Ret>(args...)` costs a single probe and an indirect call.
+// the calls through the sealed object can be made concurrently.
+// the callables registered by a shared library must not outlive it.
+
+struct dynamic_overloaded {
+    dynamic_overloaded()
+        :m_table(2)
+        ,m_seed{0}
+        ,m_shift{63}
+        ,m_sealed{false}
+    {}
+
+    // the moved-from object is empty and open for the registration
+    dynamic_overloaded(dynamic_overloaded &&r)
+        :m_entries{std::move(r.m_entries)}
+        ,m_table{std::move(r.m_table)}
+        ,m_seed{r.m_seed}
+        ,m_shift{r.m_shift}
+        ,m_sealed{r.m_sealed}
+    {
+        r.reset();
+    }
+    dynamic_overloaded& operator= (dynamic_overloaded &&r) {
+        if ( this != &r ) {
+            m_entries = std::move(r.m_entries);
+            m_table = std::move(r.m_table);
+            m_seed = r.m_seed;
+            m_shift = r.m_shift;
+            m_sealed = r.m_sealed;
+            r.reset();
+        }
+
+        return *this;
+    }
+
+    // registers a copy of `f`. throws `std::logic_error` when sealed,
+    // and `std::invalid_argument` when a callable with the same parameters is registered.
+    template<typename F>
+    dynamic_overloaded& add(F &&f) {
+        using callable_type = typename std::decay<F>::type;
+        using signature_type = details::callable_signature<callable_type>;
+        using dynamic_signature = details::dynamic_signature<
+             typename signature_type::result_type
+            ,typename signature_type::args
+        >;
+        static_assert(
+             details::const_ref_params<typename signature_type::signature>::value
+            ,"dynamic_overloaded callable-elems take the parameters by value or by const reference"
+        );
+
+        if ( sealed() ) {
+            throw std::logic_error("dynamic_overloaded::add(): the registration is sealed");
+        }
+        const details::stable_type &args_id = dynamic_signature::args_id();
+        for ( const auto &it: m_entries ) {
+            if ( it.args_id == args_id ) {
+                throw std::invalid_argument("dynamic_overloaded::add(): only unique signatures is allowed");
+            }
+        }
+
+        m_entries.push_back(entry{
+             args_id
+            ,dynamic_signature::id()
+            ,object_ptr{new callable_type(std::forward<F>(f)), &destroy<callable_type>}
+            ,reinterpret_cast<void(*)()>(&dynamic_signature::template thunk<callable_type>)
+        });
+
+        return *this;
+    }
+
+    // ends the registration: searches the seed for which the signatures
+    // are placed into the table of the power of two size without collisions.
+    // throws `std::runtime_error` when the hashes of two signatures are equal,
+    // the registration stays open in this case.
+    void seal() {
+        if ( sealed() ) {
+            return;
+        }
+
+        std::vector<std::uint64_t> hashes;
+        hashes.reserve(m_entries.size());
+        for ( const auto &it: m_entries ) {
+            hashes.push_back(it.id.hash);
+        }
+        std::sort(hashes.begin(), hashes.end());
+        if ( std::adjacent_find(hashes.begin(), hashes.end()) != hashes.end() ) {
+            throw std::runtime_error("dynamic_overloaded::seal(): the type name hashes of two signatures collide");
+        }
+
+        std::size_t size = 2;
+        unsigned shift = 63;
+        while ( size < 2 * m_entries.size() ) {
+            size <<= 1;
+            --shift;
+        }
+
+        enum: std::uint64_t { attempts = 4096 };
+        for ( ;; size <<= 1, --shift ) {
+            for ( std::uint64_t attempt = 0; attempt < attempts; ++attempt ) {
+                std::uint64_t seed = details::perfect_hash_seed(attempt);
+                if ( place(size, seed, shift) ) {
+                    m_sealed = true;
+                    return;
+                }
+            }
+        }
+    }
+
+    bool sealed() const { return m_sealed; }
+    std::size_t size() const { return m_entries.size(); }
+    // the size of the perfect hash table
+    std::size_t table_size() const { return m_table.size(); }
+
+    template<typename Signature>
+    bool exists() const {
+        using signature_type = details::callable_signature<Signature>;
+        using dynamic_signature = details::dynamic_signature<
+             typename signature_type::result_type
+            ,typename signature_type::args
+        >;
+
+        return find(dynamic_signature::id()) != nullptr;
+    }
+
+    // calls the callable-elem with the parameters of the call-site and the `Ret` result type.
+    // throws `std::out_of_range` if it's not registered, or the registration is not sealed.
+    template<typename Ret = void, typename... Args>
+    Ret call(Args &&...args) const {
+        using dynamic_signature = details::dynamic_signature<
+             Ret
+            ,typename details::transform_parameters<Args...>::type
+        >;
+
+        const slot *s = find(dynamic_signature::id());
+        if ( !s ) {
+            throw std::out_of_range("dynamic_overloaded::call(): no callable-elem with specified signature");
+        }
+
+        using thunk_type = typename dynamic_signature::thunk_type;
+        return reinterpret_cast<thunk_type>(s->thunk)(s->obj, args...);
+    }
+
+private:
+    using object_ptr = std::unique_ptr<void, void(*)(void *)>;
+
+    struct entry {
+        details::stable_type args_id;
+        details::stable_type id;
+        object_ptr obj;
+        void (*thunk)();
+    };
+    struct slot {
+        details::stable_type id;
+        void *obj;
+        void (*thunk)();
+    };
+
+    template<typename F>
+    static void destroy(void *p) { delete static_cast<F *>(p); }
+
+    // the state of the default constructed object
+    void reset() {
+        m_entries.clear();
+        m_table.assign(2, slot{});
+        m_seed = 0;
+        m_shift = 63;
+        m_sealed = false;
+    }
+
+    const slot* find(const details::stable_type &id) const {
+        const slot &s = m_table[details::perfect_hash_slot(id.hash, m_seed, m_shift)];
+        return s.thunk && s.id == id ? &s : nullptr;
+    }
+
+    bool place(std::size_t size, std::uint64_t seed, unsigned shift) {
+        std::vector<slot> table(size);
+        for ( const auto &it: m_entries ) {
+            slot &s = table[details::perfect_hash_slot(it.id.hash, seed, shift)];
+            if ( s.thunk ) {
+                return false;
+            }
+            s = slot{it.id, it.obj.get(), it.thunk};
+        }
+
+        m_table = std::move(table);
+        m_seed = seed;
+        m_shift = shift;
+
+        return true;
+    }
+
+    std::vector<entry> m_entries;
+    std::vector<slot> m_table;
+    std::uint64_t m_seed;
+    unsigned m_shift;
+    bool m_sealed;
+};
+
+/*************************************************************************************************/
+
+} // ns overloaded
+
+#endif // __OVERLOADED_DYNAMIC_HPP
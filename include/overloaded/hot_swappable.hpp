@@ -0,0 +1,177 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __OVERLOADED_HOT_SWAPPABLE_HPP
+#define __OVERLOADED_HOT_SWAPPABLE_HPP
+
+#include <overloaded.hpp>
+
+#include <atomic>
+#include <cassert>
+#include <utility>
+
+namespace overloaded {
+namespace details {
+
+/*************************************************************************************************/
+// the published callable: the call is virtual, so the reader does a single
+// indirect call after the load of the node pointer.
+
+template<typename Sig>
+struct swappable_node;
+
+template<typename Ret, typename... Args>
+struct swappable_node<Ret(Args...)> {
+    virtual ~swappable_node() {}
+    virtual Ret call(Args... args) const = 0;
+
+    swappable_node *retired_next = nullptr;
+};
+
+template<typename F, typename Sig>
+struct swappable_node_impl;
+
+template<typename F, typename Ret, typename... Args>
+struct swappable_node_impl<F, Ret(Args...)>: swappable_node<Ret(Args...)> {
+    template<typename T>
+    explicit swappable_node_impl(T &&f)
+        :f(std::forward<T>(f))
+    {}
+
+    Ret call(Args... args) const override { return f(std::forward<Args>(args)...); }
+
+    F f;
+};
+
+} // ns details
+
+/*************************************************************************************************/
+// the callable-elem which can be re-bound while the other threads are calling it.
+//
+// the call is a single acquire load of the current callable plus an indirect call.
+// `store()` publishes a new callable with a release exchange, and retires the replaced
+// one instead of destroying it, since the calls started before may still run it.
+// the retired callables are destroyed by `reclaim()`, which the user calls at a point
+// where no call started before the last `store()` is running, and by the destructor.
+//
+// the slot is move-only, so is the overloaded_function holding it by value.
+// the moved-from slot holds no callable: it must not be called until `store()`
+// publishes a new one.
+// use `o.get<Signature>()` to reach it, or pass it to `make()` as l-value to hold it by ref.
+
+template<typename Sig>
+struct hot_swappable;
+
+template<typename Ret, typename... Args>
+struct hot_swappable<Ret(Args...)> {
+    template<
+         typename F
+        ,typename = typename std::enable_if<
+            !std::is_same<typename std::decay<F>::type, hot_swappable>::value
+        >::type
+    >
+    explicit hot_swappable(F &&f)
+        :current{make_node(std::forward<F>(f))}
+        ,retired{nullptr}
+    {}
+
+    // not thread-safe, only to put the slot into an overloaded_function
+    hot_swappable(hot_swappable &&r) noexcept
+        :current{r.current.exchange(nullptr, std::memory_order_relaxed)}
+        ,retired{r.retired.exchange(nullptr, std::memory_order_relaxed)}
+    {}
+    hot_swappable(const hot_swappable &) = delete;
+    hot_swappable& operator= (const hot_swappable &) = delete;
+    hot_swappable& operator= (hot_swappable &&) = delete;
+
+    ~hot_swappable() {
+        delete current.load(std::memory_order_relaxed);
+        reclaim();
+    }
+
+    Ret operator()(Args... args) const {
+        const node_type *node = current.load(std::memory_order_acquire);
+        assert(node && "the hot_swappable is moved-from, `store()` a callable first");
+
+        return node->call(std::forward<Args>(args)...);
+    }
+
+    // publishes `f`, the calls started after the return see it.
+    // can be called by several writers concurrently.
+    template<typename F>
+    void store(F &&f) {
+        node_type *node = make_node(std::forward<F>(f));
+        retire(current.exchange(node, std::memory_order_acq_rel));
+    }
+
+    // destroys the retired callables. the caller guarantees that no call
+    // started before the last `store()` is still running.
+    void reclaim() {
+        node_type *node = retired.exchange(nullptr, std::memory_order_acquire);
+        while ( node ) {
+            node_type *next = node->retired_next;
+            delete node;
+            node = next;
+        }
+    }
+
+private:
+    using node_type = details::swappable_node<Ret(Args...)>;
+
+    template<typename F>
+    static node_type* make_node(F &&f) {
+        using impl_type = details::swappable_node_impl<
+             typename std::decay<F>::type
+            ,Ret(Args...)
+        >;
+
+        return new impl_type(std::forward<F>(f));
+    }
+
+    void retire(node_type *node) {
+        if ( !node ) {
+            return;
+        }
+
+        node_type *head = retired.load(std::memory_order_relaxed);
+        do {
+            node->retired_next = head;
+        } while ( !retired.compare_exchange_weak(
+             head
+            ,node
+            ,std::memory_order_release
+            ,std::memory_order_relaxed
+        ) );
+    }
+
+    std::atomic<node_type *> current;
+    std::atomic<node_type *> retired;
+};
+
+/*************************************************************************************************/
+
+} // ns overloaded
+
+#endif // __OVERLOADED_HOT_SWAPPABLE_HPP
@@ -0,0 +1,249 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __OVERLOADED_INSTRUMENTATION_HPP
+#define __OVERLOADED_INSTRUMENTATION_HPP
+
+#include <overloaded.hpp>
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace overloaded {
+namespace details {
+
+/*************************************************************************************************/
+// the log-linear latency histogram: the values below 8ns have a bucket each, the others
+// are split into 8 buckets per power of two, so a bucket is within 12.5% of the value.
+
+enum: std::size_t {
+     latency_sub_bits = 3
+    ,latency_subs = 1u << latency_sub_bits
+    ,latency_buckets = (64 - latency_sub_bits + 1) * latency_subs
+    ,stats_cache_line_size = 64
+};
+
+inline unsigned latency_log2(std::uint64_t v) {
+    unsigned res = 0;
+    while ( v >>= 1 ) {
+        ++res;
+    }
+
+    return res;
+}
+
+inline std::size_t latency_bucket(std::uint64_t ns) {
+    if ( ns < latency_subs ) {
+        return static_cast<std::size_t>(ns);
+    }
+    unsigned e = latency_log2(ns);
+    std::size_t sub = static_cast<std::size_t>(ns >> (e - latency_sub_bits)) & (latency_subs - 1);
+
+    return (e - latency_sub_bits + 1) * latency_subs + sub;
+}
+
+// the greatest value falling into the bucket
+inline std::uint64_t latency_bucket_limit(std::size_t bucket) {
+    if ( bucket < latency_subs ) {
+        return bucket;
+    }
+    std::size_t e = bucket / latency_subs + latency_sub_bits - 1;
+    std::uint64_t sub = bucket % latency_subs;
+    std::uint64_t low = (latency_subs + sub) << (e - latency_sub_bits);
+
+    return low + (std::uint64_t(1) << (e - latency_sub_bits)) - 1;
+}
+
+// the counters of a callable-elem, written by a single thread.
+// the leading padding keeps the counters of the different threads on different cache lines.
+struct slot_counters {
+    void record(std::uint64_t ns) {
+        calls.store(calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        total_ns.store(total_ns.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+        std::atomic<std::uint64_t> &b = buckets[latency_bucket(ns)];
+        b.store(b.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    char pad[stats_cache_line_size];
+    std::atomic<std::uint64_t> calls{0};
+    std::atomic<std::uint64_t> total_ns{0};
+    std::atomic<std::uint64_t> buckets[latency_buckets] = {};
+};
+
+} // ns details
+
+/*************************************************************************************************/
+// the merged counters of a callable-elem
+
+struct slot_snapshot {
+    std::uint64_t calls = 0;
+    std::uint64_t total_ns = 0;
+    std::array<std::uint64_t, details::latency_buckets> buckets{};
+
+    double mean_ns() const {
+        return calls ? static_cast<double>(total_ns) / calls : 0.0;
+    }
+    // the upper bound of the latency below which `p` percents of the calls are
+    std::uint64_t percentile_ns(double p) const {
+        std::uint64_t rank = static_cast<std::uint64_t>(p / 100.0 * calls + 0.5);
+        rank = rank == 0 ? 1 : rank;
+        std::uint64_t seen = 0;
+        for ( std::size_t i = 0; i < buckets.size(); ++i ) {
+            seen += buckets[i];
+            if ( seen >= rank ) {
+                return details::latency_bucket_limit(i);
+            }
+        }
+
+        return 0;
+    }
+};
+
+/*************************************************************************************************/
+// the call counters and the latency histograms of the callable-elems, per thread.
+// a thread allocates its counters on its first call, after that a call only updates
+// them with the relaxed stores. `snapshot()` merges the counters of all the threads,
+// and can be called concurrently with the calls.
+
+struct call_stats {
+    // sized by the calls-map of `o`, the overloaded_function to be instrumented
+    template<typename Map, typename Policy>
+    explicit call_stats(const overloaded_function<Map, Policy> &)
+        :call_stats{details::map_size<Map>::value}
+    {}
+    // `slots` is the number of the callable-elems, `o.size()`
+    explicit call_stats(std::size_t slots)
+        :slots{slots}
+        ,id{next_id()}
+    {}
+
+    call_stats(const call_stats &) = delete;
+    call_stats& operator= (const call_stats &) = delete;
+
+    std::size_t size() const { return slots; }
+
+    details::slot_counters& thread_slot(std::size_t idx) {
+        assert(idx < slots && "the call_stats is smaller than the calls-map");
+
+        // indexed by the stats id, the ids are never reused
+        thread_local std::vector<details::slot_counters *> blocks;
+        if ( id < blocks.size() && blocks[id] ) {
+            return blocks[id][idx];
+        }
+
+        if ( blocks.size() <= id ) {
+            blocks.resize(id+1, nullptr);
+        }
+        blocks[id] = create_block();
+
+        return blocks[id][idx];
+    }
+
+    std::vector<slot_snapshot> snapshot() const {
+        std::vector<slot_snapshot> res(slots);
+
+        std::lock_guard<std::mutex> lock{mutex};
+        for ( const auto &block: threads ) {
+            for ( std::size_t i = 0; i < slots; ++i ) {
+                const details::slot_counters &c = block[i];
+                res[i].calls += c.calls.load(std::memory_order_relaxed);
+                res[i].total_ns += c.total_ns.load(std::memory_order_relaxed);
+                for ( std::size_t b = 0; b < details::latency_buckets; ++b ) {
+                    res[i].buckets[b] += c.buckets[b].load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        return res;
+    }
+
+private:
+    static std::size_t next_id() {
+        static std::atomic<std::size_t> counter{0};
+        return counter.fetch_add(1);
+    }
+
+    details::slot_counters* create_block() {
+        std::unique_ptr<details::slot_counters[]> block{new details::slot_counters[slots]};
+
+        std::lock_guard<std::mutex> lock{mutex};
+        threads.push_back(std::move(block));
+
+        return threads.back().get();
+    }
+
+    const std::size_t slots;
+    const std::size_t id;
+
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<details::slot_counters[]>> threads;
+};
+
+/*************************************************************************************************/
+// the policy counting the calls of the callable-elems and their latencies.
+// the stats must outlive the overloaded_function:
+//     overloaded::call_stats stats{o};
+//     auto inst = overloaded::with_policy(o, overloaded::instrumented{&stats});
+
+struct instrumented {
+    explicit instrumented(call_stats *stats)
+        :stats{stats}
+    {}
+
+    call_stats *stats;
+
+    template<typename Map, std::size_t I>
+    struct scope {
+        template<typename... Args>
+        explicit scope(const instrumented &policy, const Args &...)
+            :counters(policy.stats->thread_slot(I))
+            ,start{std::chrono::steady_clock::now()}
+        {}
+        ~scope() {
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start
+            ).count();
+            counters.record(static_cast<std::uint64_t>(ns));
+        }
+
+        scope(const scope &) = delete;
+        scope& operator= (const scope &) = delete;
+
+        details::slot_counters &counters;
+        std::chrono::steady_clock::time_point start;
+    };
+};
+
+/*************************************************************************************************/
+
+} // ns overloaded
+
+#endif // __OVERLOADED_INSTRUMENTATION_HPP
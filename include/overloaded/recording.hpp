@@ -0,0 +1,340 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __OVERLOADED_RECORDING_HPP
+#define __OVERLOADED_RECORDING_HPP
+
+#include <overloaded.hpp>
+#include <overloaded/wire.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace overloaded {
+namespace details {
+
+/*************************************************************************************************/
+// the log file: the header followed by `slots` records of `slot_size` bytes, used as a ring.
+// the record is `[uint32 frame size][uint32 reserved][int64 timestamp, ns][wire frame]`.
+
+// "OVLDCLOG" in the little-endian byte order
+enum: std::uint64_t { call_log_magic = 0x474f4c43444c564fULL };
+
+struct call_log_header {
+    std::uint64_t magic;
+    std::uint64_t slot_size;
+    std::uint64_t slots;
+    std::atomic<std::uint64_t> written;
+    std::atomic<std::uint64_t> dropped;
+    char reserved[64 - 5*sizeof(std::uint64_t)];
+};
+
+struct call_record_header {
+    std::uint32_t size;
+    std::uint32_t reserved;
+    std::int64_t timestamp;
+};
+
+// the ring has a slot, the slot has a room for a frame after the record header,
+// and the ring fits into `space` bytes
+inline bool call_log_geometry(std::uint64_t slots, std::uint64_t slot_size, std::uint64_t space) {
+    return slots != 0
+        && slot_size > sizeof(call_record_header)
+        && slots <= space / slot_size
+    ;
+}
+
+struct mapped_file {
+    void *data;
+    std::size_t size;
+};
+
+struct unmap_files {
+    ~unmap_files() {
+        for ( const auto &f: files ) {
+            ::munmap(f.data, f.size);
+        }
+    }
+
+    std::vector<mapped_file> files;
+};
+
+inline mapped_file map_file(const std::string &path, std::size_t size, bool create) {
+    int fd = create
+        ? ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)
+        : ::open(path.c_str(), O_RDONLY)
+    ;
+    if ( fd == -1 ) {
+        throw std::system_error(errno, std::generic_category(), "overloaded: can't open " + path);
+    }
+
+    struct stat st;
+    if ( create ? ::ftruncate(fd, static_cast<off_t>(size)) != 0 : ::fstat(fd, &st) != 0 ) {
+        int err = errno;
+        ::close(fd);
+        throw std::system_error(err, std::generic_category(), "overloaded: can't size " + path);
+    }
+    if ( !create ) {
+        size = static_cast<std::size_t>(st.st_size);
+    }
+
+    void *data = ::mmap(
+         nullptr
+        ,size
+        ,create ? PROT_READ | PROT_WRITE : PROT_READ
+        ,create ? MAP_SHARED : MAP_PRIVATE
+        ,fd
+        ,0
+    );
+    int err = errno;
+    ::close(fd);
+    if ( data == MAP_FAILED ) {
+        throw std::system_error(err, std::generic_category(), "overloaded: can't map " + path);
+    }
+
+    return {data, size};
+}
+
+} // ns details
+
+/*************************************************************************************************/
+// the binary log of the calls, one memory-mapped ring file per calling thread,
+// named `<prefix>.<N>`. a thread creates its file on its first call, so that call
+// makes the open/ftruncate/mmap syscalls, unless the thread calls `attach()` before;
+// after that a record is a copy into the mapping, with no locks and no syscalls.
+// when a ring is full the oldest records are overwritten; the calls which don't fit
+// into a slot are dropped and counted. the parameters must be supported by `wire.hpp`.
+// throws `std::invalid_argument` when the slot can't hold a record or the ring is empty.
+
+struct call_log {
+    explicit call_log(std::string prefix, std::size_t slots = 1u << 16, std::size_t slot_size = 128)
+        :prefix{std::move(prefix)}
+        ,slots{slots}
+        ,slot_size{(slot_size + 15) / 16 * 16}
+        ,id{next_id()}
+    {
+        // the rounding of a huge `slot_size` wraps to below the record header
+        if ( !details::call_log_geometry(
+             this->slots
+            ,this->slot_size
+            ,SIZE_MAX - sizeof(details::call_log_header)) )
+        {
+            throw std::invalid_argument("overloaded::call_log: invalid slots or slot_size");
+        }
+    }
+
+    call_log(const call_log &) = delete;
+    call_log& operator= (const call_log &) = delete;
+
+    template<typename Map, std::size_t I, typename... Args>
+    void record(const Args &...args) {
+        using columns = typename details::bucket_columns<typename details::key_at<Map, I>::type>::type;
+
+        details::call_log_header &header = thread_ring();
+        std::uint64_t pos = header.written.load(std::memory_order_relaxed);
+        std::byte *slot = reinterpret_cast<std::byte *>(&header + 1) + (pos % slots) * slot_size;
+
+        details::wire_buffer out{slot + sizeof(details::call_record_header), slot + slot_size};
+        details::wire_append(out, static_cast<details::wire_size>(I));
+        details::wire_encoder<columns>::write(out, args...);
+        if ( out.overflow ) {
+            header.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        details::call_record_header record{
+             static_cast<std::uint32_t>(out.p - slot - sizeof(details::call_record_header))
+            ,0
+            ,std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+             ).count()
+        };
+        std::memcpy(slot, &record, sizeof(record));
+        header.written.store(pos+1, std::memory_order_release);
+    }
+
+    // creates the file of the calling thread, if it has none yet,
+    // to keep the syscalls out of the first recorded call
+    void attach() {
+        thread_ring();
+    }
+
+    // the files created so far
+    std::vector<std::string> paths() const {
+        std::lock_guard<std::mutex> lock{mutex};
+        return names;
+    }
+
+private:
+    static std::size_t next_id() {
+        static std::atomic<std::size_t> counter{0};
+        return counter.fetch_add(1);
+    }
+
+    details::call_log_header& thread_ring() {
+        // indexed by the log id, the ids are never reused
+        thread_local std::vector<details::call_log_header *> rings;
+        if ( id < rings.size() && rings[id] ) {
+            return *rings[id];
+        }
+
+        if ( rings.size() <= id ) {
+            rings.resize(id+1, nullptr);
+        }
+        rings[id] = create_ring();
+
+        return *rings[id];
+    }
+
+    details::call_log_header* create_ring() {
+        std::lock_guard<std::mutex> lock{mutex};
+
+        std::string path = prefix + "." + std::to_string(names.size());
+        details::mapped_file file = details::map_file(
+             path
+            ,sizeof(details::call_log_header) + slots * slot_size
+            ,true
+        );
+        mapped.files.push_back(file);
+        names.push_back(std::move(path));
+
+        auto *header = ::new(file.data) details::call_log_header{};
+        header->magic = details::call_log_magic;
+        header->slot_size = slot_size;
+        header->slots = slots;
+
+        return header;
+    }
+
+    const std::string prefix;
+    const std::size_t slots;
+    const std::size_t slot_size;
+    const std::size_t id;
+
+    mutable std::mutex mutex;
+    details::unmap_files mapped;
+    std::vector<std::string> names;
+};
+
+/*************************************************************************************************/
+// the policy recording the calls of the callable-elems into a `call_log`,
+// before the call. the log must outlive the overloaded_function:
+//     auto rec = overloaded::with_policy(o, overloaded::recording{&log});
+
+struct recording {
+    explicit recording(call_log *log)
+        :log{log}
+    {}
+
+    call_log *log;
+
+    template<typename Map, std::size_t I>
+    struct scope {
+        template<typename... Args>
+        explicit scope(const recording &policy, const Args &...args) {
+            policy.log->template record<Map, I>(args...);
+        }
+    };
+};
+
+/*************************************************************************************************/
+
+// re-issues the calls from the files of a `call_log`, ordered by the timestamps,
+// the recorded strings are passed as views into the mapped files.
+// `o` must have the same signatures in the same order as the recorded one.
+// returns the number of the calls made.
+template<typename Map, typename Policy>
+std::size_t replay(const std::vector<std::string> &paths, const overloaded_function<Map, Policy> &o) {
+    struct entry {
+        std::int64_t timestamp;
+        const std::byte *frame;
+        std::size_t size;
+    };
+
+    details::unmap_files mapped;
+    std::vector<entry> entries;
+    for ( const auto &path: paths ) {
+        mapped.files.push_back(details::map_file(path, 0, false));
+
+        const details::mapped_file &file = mapped.files.back();
+        const auto *header = static_cast<const details::call_log_header *>(file.data);
+        if ( file.size < sizeof(*header)
+            || header->magic != details::call_log_magic
+            || !details::call_log_geometry(header->slots, header->slot_size, file.size - sizeof(*header)) )
+        {
+            throw std::runtime_error("overloaded: not a call log: " + path);
+        }
+
+        std::uint64_t written = header->written.load(std::memory_order_acquire);
+        std::uint64_t count = std::min<std::uint64_t>(written, header->slots);
+        const std::byte *data = reinterpret_cast<const std::byte *>(header + 1);
+        for ( std::uint64_t pos = written - count; pos != written; ++pos ) {
+            const std::byte *slot = data + (pos % header->slots) * header->slot_size;
+            details::call_record_header record;
+            std::memcpy(&record, slot, sizeof(record));
+            entries.push_back({
+                 record.timestamp
+                ,slot + sizeof(record)
+                ,std::min<std::size_t>(record.size, header->slot_size - sizeof(record))
+            });
+        }
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [](const entry &l, const entry &r) {
+        return l.timestamp < r.timestamp;
+    });
+
+    std::size_t calls = 0;
+    for ( const auto &e: entries ) {
+        calls += dispatch_from(o, e.frame, e.size) != 0;
+    }
+
+    return calls;
+}
+
+template<typename Map, typename Policy>
+std::size_t replay(const std::string &path, const overloaded_function<Map, Policy> &o) {
+    return replay(std::vector<std::string>{path}, o);
+}
+
+/*************************************************************************************************/
+
+} // ns overloaded
+
+#endif // __OVERLOADED_RECORDING_HPP
@@ -0,0 +1,337 @@
+
+// The MIT License (MIT)
+//
+// Copyright (c) 2013-2023 niXman (github dot nixman at pm.me)
+//
+// This file is the part of the project 'Overloaded':
+//       github.com/nixman/overloaded
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+// the Software, and to permit persons to whom the Software is furnished to do so,
+// subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#ifndef __OVERLOADED_WIRE_HPP
+#define __OVERLOADED_WIRE_HPP
+
+#if __cplusplus < 201703L
+#   error "overloaded/wire.hpp requires C++17"
+#endif // __cplusplus < 201703L
+
+#include <overloaded.hpp>
+#include <overloaded/bucketed_queue.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#if __has_include(<span>)
+#   include <span>
+#endif
+
+namespace overloaded {
+
+/*************************************************************************************************/
+// the binary call frame: `[uint32 slot index][fields...]`, in the native byte order.
+//
+// the field of a parameter depends on its type:
+//   * trivially copyable `T`: `sizeof(T)` bytes, copied out of the buffer
+//   * `std::string_view`: `[uint32 size][chars]`, passed as a view into the buffer
+//   * `const char *`: `[uint32 size][chars]['\0']`, passed as a pointer into the buffer
+//   * `std::span<const T>` (C++20): `[uint32 count][padding to alignof(T)][elements]`,
+//     passed as a view into the buffer. the padding is computed from the offset in the
+//     stream, so the buffer must be aligned as the `mmap`'d and `operator new`'d memory is.
+// no field allocates on decoding, so the frames can be dispatched from a `mmap`'d file.
+
+namespace details {
+
+using wire_size = std::uint32_t;
+
+struct wire_reader {
+    const std::byte *p;
+    const std::byte *end;
+
+    std::size_t left() const { return static_cast<std::size_t>(end - p); }
+};
+
+// the output of the encoder is a `std::vector<std::byte>`, or a `wire_buffer`
+inline void wire_append_bytes(std::vector<std::byte> &out, const void *data, std::size_t size) {
+    const std::byte *p = static_cast<const std::byte *>(data);
+    out.insert(out.end(), p, p + size);
+}
+inline std::uintptr_t wire_offset(const std::vector<std::byte> &out) {
+    return out.size();
+}
+
+// the fixed-size output, `overflow` is set when the frame doesn't fit
+struct wire_buffer {
+    std::byte *p;
+    std::byte *end;
+    bool overflow = false;
+};
+
+inline void wire_append_bytes(wire_buffer &out, const void *data, std::size_t size) {
+    if ( out.overflow || static_cast<std::size_t>(out.end - out.p) < size ) {
+        out.overflow = true;
+        return;
+    }
+    std::memcpy(out.p, data, size);
+    out.p += size;
+}
+inline std::uintptr_t wire_offset(const wire_buffer &out) {
+    return reinterpret_cast<std::uintptr_t>(out.p);
+}
+
+template<typename Out, typename T>
+void wire_append(Out &out, const T &v) {
+    wire_append_bytes(out, &v, sizeof(T));
+}
+
+template<typename T>
+bool wire_read(wire_reader &r, T &v) {
+    if ( r.left() < sizeof(T) ) {
+        return false;
+    }
+    std::memcpy(&v, r.p, sizeof(T));
+    r.p += sizeof(T);
+
+    return true;
+}
+
+template<typename T>
+struct wire_field {
+    static_assert(
+         std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value
+        ,"the parameter type is not supported by the wire format"
+    );
+
+    template<typename Out>
+    static void write(Out &out, const T &v) {
+        wire_append(out, v);
+    }
+    static bool read(wire_reader &r, T &v) {
+        return wire_read(r, v);
+    }
+};
+
+template<>
+struct wire_field<std::string_view> {
+    template<typename Out>
+    static void write(Out &out, std::string_view v) {
+        wire_append(out, static_cast<wire_size>(v.size()));
+        wire_append_bytes(out, v.data(), v.size());
+    }
+    static bool read(wire_reader &r, std::string_view &v) {
+        wire_size size;
+        if ( !wire_read(r, size) || r.left() < size ) {
+            return false;
+        }
+        v = std::string_view{reinterpret_cast<const char *>(r.p), size};
+        r.p += size;
+
+        return true;
+    }
+};
+
+template<>
+struct wire_field<const char *> {
+    template<typename Out>
+    static void write(Out &out, const char *v) {
+        wire_field<std::string_view>::write(out, v);
+        wire_append(out, std::byte{0});
+    }
+    static bool read(wire_reader &r, const char *&v) {
+        std::string_view sv;
+        if ( !wire_field<std::string_view>::read(r, sv) || r.left() < 1 || *r.p != std::byte{0} ) {
+            return false;
+        }
+        v = sv.data();
+        r.p += 1;
+
+        return true;
+    }
+};
+
+#if defined(__cpp_lib_span)
+template<typename T>
+struct wire_field<std::span<const T>> {
+    static_assert(
+         std::is_trivially_copyable<T>::value
+        ,"the span element type is not supported by the wire format"
+    );
+
+    template<typename Out>
+    static void write(Out &out, std::span<const T> v) {
+        wire_append(out, static_cast<wire_size>(v.size()));
+        for ( std::size_t pad = padding(wire_offset(out)); pad != 0; --pad ) {
+            wire_append(out, std::byte{0});
+        }
+        wire_append_bytes(out, v.data(), v.size_bytes());
+    }
+    static bool read(wire_reader &r, std::span<const T> &v) {
+        wire_size count;
+        if ( !wire_read(r, count) ) {
+            return false;
+        }
+        std::size_t pad = padding(reinterpret_cast<std::uintptr_t>(r.p));
+        if ( r.left() < pad || (r.left() - pad) / sizeof(T) < count ) {
+            return false;
+        }
+        r.p += pad;
+        v = std::span<const T>{reinterpret_cast<const T *>(r.p), count};
+        r.p += count * sizeof(T);
+
+        return true;
+    }
+
+    static std::size_t padding(std::uintptr_t pos) {
+        return (alignof(T) - pos % alignof(T)) % alignof(T);
+    }
+};
+#endif // __cpp_lib_span
+
+/*************************************************************************************************/
+
+template<typename Key>
+struct wire_decoder;
+
+template<typename... Types>
+struct wire_decoder<type_list<Types...>> {
+    using tuple_type = std::tuple<Types...>;
+
+    static bool read(wire_reader &r, tuple_type &t) {
+        return read_impl(r, t, std::index_sequence_for<Types...>{});
+    }
+
+private:
+    template<std::size_t... Is>
+    static bool read_impl(wire_reader &r, tuple_type &t, std::index_sequence<Is...>) {
+        return (wire_field<Types>::read(r, std::get<Is>(t)) && ...);
+    }
+};
+
+template<typename Map, typename Policy, std::size_t I>
+std::size_t wire_thunk(const overloaded_function<Map, Policy> &o, wire_reader r, const std::byte *frame) {
+    using columns = typename bucket_columns<typename key_at<Map, I>::type>::type;
+    using decoder = wire_decoder<columns>;
+    using caller = tuple_caller<
+         typename decoder::tuple_type
+        ,typename signature_params<typename holder_signature<typename value_at<Map, I>::type>::type>::type
+    >;
+
+    typename decoder::tuple_type args;
+    if ( !decoder::read(r, args) ) {
+        return 0;
+    }
+    caller::apply(o, args);
+
+    return static_cast<std::size_t>(r.p - frame);
+}
+
+template<typename Map, typename Policy, std::size_t... Is>
+std::size_t wire_dispatch(
+     const overloaded_function<Map, Policy> &o
+    ,const std::byte *buf
+    ,std::size_t len
+    ,std::index_sequence<Is...>)
+{
+    using thunk_type = std::size_t(*)(
+         const overloaded_function<Map, Policy> &
+        ,wire_reader
+        ,const std::byte *
+    );
+    static constexpr thunk_type table[] = {&wire_thunk<Map, Policy, Is>...};
+
+    wire_reader r{buf, buf + len};
+    wire_size id;
+    if ( !wire_read(r, id) || id >= sizeof...(Is) ) {
+        return 0;
+    }
+
+    return table[id](o, r, buf);
+}
+
+// the argument converts to the parameter implicitly and without narrowing
+template<typename To, typename From, typename = void>
+struct is_wire_convertible: std::false_type {};
+
+template<typename To, typename From>
+struct is_wire_convertible<To, From, std::void_t<decltype(To{std::declval<From>()})>>
+    :std::is_convertible<From, To>
+{};
+
+template<typename Key>
+struct wire_encoder;
+
+template<typename... Types>
+struct wire_encoder<type_list<Types...>> {
+    template<typename Out, typename... Args>
+    static void write(Out &out, Args &&...args) {
+        static_assert(
+             sizeof...(Types) == sizeof...(Args)
+            ,"the number of the arguments doesn't match the signature"
+        );
+        static_assert(
+             (is_wire_convertible<Types, Args &&>::value && ...)
+            ,"the argument doesn't convert to the parameter of the signature implicitly, or narrows"
+        );
+
+        (wire_field<Types>::write(out, Types{std::forward<Args>(args)}), ...);
+    }
+};
+
+} // ns details
+
+/*************************************************************************************************/
+
+// appends the frame of the call to the callable-elem with the specified signature.
+// the arguments are converted to the parameter types of the signature, for example
+// a `std::string` to `std::string_view`; the explicit and the narrowing conversions are rejected.
+template<typename Signature, typename Map, typename Policy, typename... Args>
+void wire_encode(const overloaded_function<Map, Policy> &, std::vector<std::byte> &out, Args &&...args) {
+    using key = typename details::signature_key<Map, Signature>::type;
+    static_assert(
+         details::has_key<Map, key>::value
+        ,"calls-map doesn't contains callable-elem with specified parameters"
+    );
+
+    details::wire_append(out, static_cast<details::wire_size>(details::index_of_key<Map, key>::value));
+    details::wire_encoder<typename details::bucket_columns<key>::type>::write(
+         out
+        ,std::forward<Args>(args)...
+    );
+}
+
+// decodes the frame at `buf` and calls the callable-elem it refers to.
+// returns the size of the frame, or 0 when the slot index is unknown,
+// or the frame is truncated or malformed; nothing is called in this case.
+template<typename Map, typename Policy>
+std::size_t dispatch_from(const overloaded_function<Map, Policy> &o, const std::byte *buf, std::size_t len) {
+    return details::wire_dispatch(
+         o
+        ,buf
+        ,len
+        ,std::make_index_sequence<details::map_size<Map>::value>{}
+    );
+}
+
+/*************************************************************************************************/
+
+} // ns overloaded
+
+#endif // __OVERLOADED_WIRE_HPP
@@ -25,11 +25,30 @@
 
 #undef NDEBUG
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include <cassert>
+#include <cstdint>
+#include <cstdio>
 
 #include <overloaded.hpp>
+#include <overloaded/async.hpp>
+#include <overloaded/bucketed_queue.hpp>
+#include <overloaded/dynamic.hpp>
+#include <overloaded/hot_swappable.hpp>
+#include <overloaded/instrumentation.hpp>
+#if __cplusplus >= 201703L
+#   include <overloaded/recording.hpp>
+#   include <overloaded/wire.hpp>
+#endif // __cplusplus >= 201703L
+#if __cplusplus >= 202002L
+#   include <overloaded/coroutine.hpp>
+#endif // __cplusplus >= 202002L
 
 /***************************************************************************/
 
@@ -50,6 +69,7 @@ __attribute__ ((noinline))
 int f4(int v) {std::cout << __PRETTY_FUNCTION__ << std::endl; f4_counter++; return v+2;}
 
 struct callable {
+    callable() = default;
     callable(const callable &) = delete;
     callable& operator= (const callable &) = delete;
 
@@ -59,6 +79,134 @@ struct callable {
     int operator()(int l, int r) const { return l+r;}
 };
 
+struct tracked {
+    static int copies;
+    static int moves;
+
+    tracked() = default;
+    tracked(const tracked &) { ++copies; }
+    tracked(tracked &&) { ++moves; }
+};
+
+int tracked::copies = 0;
+int tracked::moves = 0;
+
+// the callable which copy throws on demand, counting the live objects
+struct throwing_copy {
+    static bool fail;
+    static int alive;
+
+    explicit throwing_copy(int v): v{v} { ++alive; }
+    throwing_copy(const throwing_copy &r): v{r.v} {
+        if ( fail ) { throw std::runtime_error("copy"); }
+        ++alive;
+    }
+    throwing_copy(throwing_copy &&r) noexcept: v{r.v} { ++alive; }
+    ~throwing_copy() { --alive; }
+
+    int operator()(int) const { return v; }
+
+    int v;
+};
+
+bool throwing_copy::fail = false;
+int throwing_copy::alive = 0;
+
+struct accumulator {
+    int sum = 0;
+
+    int add(int v) { return sum += v; }
+    int get() const { return sum; }
+};
+
+// the hierarchy for the double dispatch
+struct shape {
+    explicit shape(std::size_t id)
+        :id{id}
+    {}
+
+    std::size_t dispatch_id() const { return id; }
+
+    const std::size_t id;
+};
+
+struct circle;
+struct box;
+struct triangle;
+using shapes = overloaded::type_list<circle, box, triangle>;
+
+struct circle: shape {
+    circle(): shape(overloaded::dispatch_id_of<circle, shapes>::value) {}
+};
+struct box: shape {
+    box(): shape(overloaded::dispatch_id_of<box, shapes>::value) {}
+};
+struct triangle: shape {
+    triangle(): shape(overloaded::dispatch_id_of<triangle, shapes>::value) {}
+};
+
+// the messages of the handlers registered at run time
+template<int N>
+struct plugin_msg {
+    int v;
+};
+
+inline void register_plugin_msgs(overloaded::dynamic_overloaded &, std::integral_constant<int, 0>) {}
+
+template<int N>
+void register_plugin_msgs(overloaded::dynamic_overloaded &d, std::integral_constant<int, N>) {
+    d.add([](const plugin_msg<N> &m) { return m.v + N; });
+    register_plugin_msgs(d, std::integral_constant<int, N-1>{});
+}
+
+struct running_max {
+    int max = 0;
+
+    int operator()(int v) { return max = std::max(max, v); }
+};
+
+#if __cplusplus >= 202002L
+// the lazy task with the frames from `frame_pool`
+template<typename T>
+struct task {
+    struct promise_type: overloaded::pooled_frame {
+        struct final_awaiter {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                auto c = h.promise().continuation;
+                return c ? c : std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+        };
+
+        task get_return_object() { return task{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        final_awaiter final_suspend() noexcept { return {}; }
+        void return_value(T v) { value = std::move(v); }
+        void unhandled_exception() { std::terminate(); }
+
+        T value{};
+        std::coroutine_handle<> continuation;
+    };
+
+    explicit task(std::coroutine_handle<promise_type> h) :h{h} {}
+    task(task &&r) noexcept :h{std::exchange(r.h, {})} {}
+    ~task() { if ( h ) h.destroy(); }
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> c) noexcept {
+        h.promise().continuation = c;
+        return h;
+    }
+    T await_resume() { return std::move(h.promise().value); }
+
+    // runs the task which doesn't wait for anything but the other tasks
+    T get() { h.resume(); return std::move(h.promise().value); }
+
+    std::coroutine_handle<promise_type> h;
+};
+#endif // __cplusplus >= 202002L
+
 /***************************************************************************/
 
 #define RT_TEST(expected, ...) \
@@ -130,6 +278,77 @@ int main() {
         RT_TEST(6, r);
         RT_TEST(1, counter);
     }
+    { // lambda r-value is held by value, not by std::function
+        auto counter = 0;
+        auto l = [&counter](int v){ counter++; return v*2;};
+        using holder_type = overloaded::details::callable_holder<decltype(l)>::type;
+        CT_TEST(true, std::is_same<holder_type, decltype(l)>::value);
+
+        auto o = overloaded::make(std::move(l));
+        CT_TEST(true, sizeof(o) == sizeof(l));
+        CT_TEST(true, sizeof(o) < sizeof(std::function<int(int)>));
+
+        auto r = o(3);
+        RT_TEST(6, r);
+        RT_TEST(1, counter);
+    }
+    { // stateless lambdas r-value
+        auto o = overloaded::make(
+             [](int v){ return v*2; }
+            ,[](double v){ return v*3; }
+        );
+        CT_TEST(true, sizeof(o) < sizeof(std::function<int(int)>));
+
+        RT_TEST(6, o(3));
+        RT_TEST(6.0, o(2.0));
+    }
+    { // mutable lambda r-value is held by value and called through a non-const holder
+        auto n = 0;
+        auto l = [n](int v) mutable { return n += v; };
+        using holder_type = overloaded::details::callable_holder<decltype(l)>::type;
+        CT_TEST(true, std::is_same<holder_type, decltype(l)>::value);
+
+        auto o = overloaded::make(std::move(l), [](double v){ return v*3; });
+        CT_TEST(true, sizeof(o) == sizeof(int));
+
+        o(2);
+        auto r = o(3);
+        RT_TEST(5, r);
+        r = o.invoke(4);
+        RT_TEST(9, r);
+
+        const auto &c = o;
+        RT_TEST(6.0, c(2.0));
+    }
+    { // stateful functor with non-const operator()
+        auto o = overloaded::make(running_max{}, [](const std::string &s){ return s.size(); });
+        CT_TEST(true, sizeof(o) == sizeof(running_max));
+        CT_TEST(true, o.exists<int(int)>());
+
+        o(3);
+        o(7);
+        auto r = o(5);
+        RT_TEST(7, r);
+        RT_TEST(7, o.get<int(int)>().max);
+
+        auto copy = o;
+        r = copy(9);
+        RT_TEST(9, r);
+        RT_TEST(7, o.get<int(int)>().max);
+    }
+    { // stateful callable-elems through the batch, broadcast and by-index calls
+        int n = 0;
+        auto o = overloaded::make([n](int v) mutable { return n += v; });
+
+        const int values[] = {1, 2, 3};
+        int results[3] = {};
+        o.invoke_each(values, results);
+        RT_TEST(6, results[2]);
+        o.invoke_each(values);
+        o.broadcast(4);
+        auto r = o.invoke_by_index(0, 0);
+        RT_TEST(16, r);
+    }
     { // lambda l-value
         auto counter = 0;
         auto l = [&counter](int v){ counter++; return v*2;};
@@ -217,6 +436,1087 @@ int main() {
         RT_TEST(6, r);
     }
 
+    { // inplace slots
+        using overloaded_type = overloaded::make_overloaded_inplace<
+             16
+            ,int(int)
+            ,decltype(&f1)
+        >::type;
+
+        auto counter = 0;
+        overloaded_type o = overloaded::make(
+             [&counter](int v){ counter++; return v*2; }
+            ,&f1
+        );
+        CT_TEST(true, o.size() == 2);
+        CT_TEST(true, o.exists<int(int)>());
+        CT_TEST(true, o.exists<void()>());
+        CT_TEST(true, (sizeof(overloaded::inplace_function<int(int), 16>) < sizeof(o)));
+
+        auto r = o(3);
+        RT_TEST(6, r);
+        RT_TEST(1, counter);
+
+        auto o2 = o;
+        r = o2(4);
+        RT_TEST(8, r);
+        RT_TEST(2, counter);
+
+        RT_TEST(0, f1_counter);
+        o2();
+        RT_TEST(1, f1_counter);
+        f1_counter = 0;
+    }
+
+    { // inplace slot assignment is intact when the copy throws
+        {
+            using slot_type = overloaded::inplace_function<int(int), 16>;
+            CT_TEST(true, std::is_nothrow_move_constructible<slot_type>::value);
+            CT_TEST(true, std::is_nothrow_move_assignable<slot_type>::value);
+
+            slot_type a{throwing_copy{1}};
+            slot_type b{throwing_copy{2}};
+            RT_TEST(2, throwing_copy::alive);
+
+            throwing_copy::fail = true;
+            bool thrown = false;
+            try { a = b; } catch (const std::runtime_error &) { thrown = true; }
+            throwing_copy::fail = false;
+            RT_TEST(true, thrown);
+            RT_TEST(2, throwing_copy::alive);
+            auto r = a(0);
+            RT_TEST(1, r);
+
+            a = b;
+            r = a(0);
+            RT_TEST(2, r);
+            a = slot_type{[](int v) { return v; }};
+            RT_TEST(1, throwing_copy::alive);
+        }
+        RT_TEST(0, throwing_copy::alive);
+    }
+
+    { // invoke by runtime index
+        struct tag_add{};
+        struct tag_sub{};
+        struct tag_mul{};
+
+        auto o = overloaded::make(
+             [](tag_add, int l, int r) { return l+r; }
+            ,[](tag_sub, int l, int r) { return l-r; }
+            ,[](tag_mul, int l, int r) { return l*r; }
+        );
+        CT_TEST(0, o.index_of<int(tag_add, int, int)>());
+        CT_TEST(1, o.index_of<int(tag_sub, int, int)>());
+        CT_TEST(2, o.index_of<int(tag_mul, int, int)>());
+
+        auto r = o.invoke_by_index(0, 3, 2);
+        RT_TEST(5, r);
+        r = o.invoke_by_index(1, 3, 2);
+        RT_TEST(1, r);
+        r = o.invoke_by_index(o.index_of<int(tag_mul, int, int)>(), 3, 2);
+        RT_TEST(6, r);
+
+        bool thrown = false;
+        try {
+            o.invoke_by_index(3, 3, 2);
+        } catch (const std::out_of_range &) {
+            thrown = true;
+        }
+        RT_TEST(true, thrown);
+    }
+    { // invoke by runtime index without tags
+        auto o = overloaded::make(f2);
+        auto r = o.invoke_by_index(0, 4);
+        RT_TEST(8, r);
+        RT_TEST(1, f2_counter);
+        f2_counter = 0;
+    }
+
+    { // batched invoke over a range
+        auto o = overloaded::make(
+             [](int v) { return v*2; }
+            ,[](double v) { return v/2; }
+        );
+
+        std::vector<int> in{1, 2, 3, 4};
+        std::vector<int> out(in.size());
+        auto end = o.invoke_each(in, out.begin());
+        RT_TEST(true, end == out.end());
+        RT_TEST(true, (out == std::vector<int>{2, 4, 6, 8}));
+
+        std::vector<double> dout;
+        o.invoke_each(std::vector<double>{2.0, 4.0}, std::back_inserter(dout));
+        RT_TEST(true, (dout == std::vector<double>{1.0, 2.0}));
+    }
+    { // batched invoke over zipped ranges
+        int calls = 0;
+        auto o = overloaded::make(
+             [](int l, int r) { return l+r; }
+            ,[&calls](int) { ++calls; }
+        );
+
+        std::vector<int> l{1, 2, 3, 4};
+        const int r[] = {10, 20, 30};
+        int out[3] = {};
+        auto end = o.invoke_each(overloaded::zip(l, r), out);
+        RT_TEST(true, end == out + 3);
+        RT_TEST(11, out[0]);
+        RT_TEST(22, out[1]);
+        RT_TEST(33, out[2]);
+
+        o.invoke_each(l);
+        RT_TEST(4, calls);
+    }
+
+    { // signature-bucketed queue
+        std::string calls;
+        auto o = overloaded::make(
+             [&calls](int v) { calls += "i" + std::to_string(v); }
+            ,[&calls](const std::string &v, int n) { calls += v + std::to_string(n); }
+            ,[&calls]() { calls += "-"; }
+        );
+
+        overloaded::bucketed_queue<decltype(o)> queue;
+        queue.push(1);
+        queue.push(std::string{"s"}, 1);
+        queue.push();
+        queue.push(2);
+        queue.push(std::string{"s"}, 2);
+        RT_TEST(5u, queue.size());
+
+        auto n = queue.drain(o);
+        RT_TEST(5u, n);
+        RT_TEST(true, queue.empty());
+        RT_TEST(std::string{"i1i2s1s2-"}, calls);
+    }
+    { // signature-bucketed queue pushed into by its callable-elems during the drain
+        std::function<void(int)> push_int;
+        std::function<void(std::string)> push_str;
+        std::string calls;
+        auto o = overloaded::make(
+             [&](int v) {
+                calls += 'i' + std::to_string(v);
+                for ( int i = 0; i < 64; ++i ) { push_int(v+1); }
+                push_str(std::to_string(v));
+             }
+            ,[&](const std::string &s) { calls += 's' + s; }
+        );
+        overloaded::bucketed_queue<decltype(o)> queue;
+        push_int = [&queue](int v) { queue.push(v); };
+        push_str = [&queue](std::string s) { queue.push(std::move(s)); };
+
+        queue.push(1);
+        auto n = queue.drain(o);
+        RT_TEST(2u, n);
+        RT_TEST(std::string{"i1s1"}, calls);
+        RT_TEST(64u, queue.size());
+
+        queue.clear();
+        RT_TEST(true, queue.empty());
+    }
+    { // signature-bucketed queue with the value-category preserving keys
+        auto o = overloaded::make_exact(
+             [](const tracked &) { return 1; }
+            ,[](tracked &&t) { tracked sink{std::move(t)}; return 2; }
+        );
+        overloaded::bucketed_queue<decltype(o)> queue;
+        queue.push(tracked{});
+        RT_TEST(1, tracked::moves);
+        queue.drain(o);
+        RT_TEST(0, tracked::copies);
+        RT_TEST(2, tracked::moves);
+        tracked::moves = 0;
+    }
+    { // signature-bucketed queue passing l-value refs
+        auto o = overloaded::make(f3);
+        overloaded::bucketed_queue<decltype(o)> queue;
+        queue.push(3);
+        queue.drain(o);
+        RT_TEST(1, f3_counter);
+        f3_counter = 0;
+    }
+
+#if __cplusplus >= 201703L
+    { // std::variant visitation
+        auto o = overloaded::make(
+             [](int v) { return v*2; }
+            ,[](const std::string &v) { return static_cast<int>(v.size()); }
+        );
+
+        std::variant<int, std::string> v{3};
+        auto r = o.visit(v);
+        RT_TEST(6, r);
+
+        v = std::string{"four"};
+        r = o.visit(v);
+        RT_TEST(4, r);
+    }
+    { // batch std::variant visitation
+        int ints = 0;
+        std::string order;
+        auto o = overloaded::make(
+             [&ints](int v) { ints += v; }
+            ,[&order](char c) { order += c; }
+        );
+
+        std::vector<std::variant<int, char>> events{1, 'a', 2, 'b', 3, 'c'};
+        o.visit_all(events);
+        RT_TEST(6, ints);
+        RT_TEST(std::string{"abc"}, order);
+    }
+    { // batch std::variant visitation grouped by the alternative, through the policy
+        std::string seq;
+        int n = 0;
+        auto o = overloaded::make(
+             [&seq, n](int v) mutable { n += v; seq += std::to_string(n); }
+            ,[&seq](char c) { seq += c; }
+        );
+        overloaded::call_stats stats{o};
+        auto inst = overloaded::with_policy(o, overloaded::instrumented{&stats});
+
+        std::vector<std::variant<int, char>> events{1, 'a', 2, 'b', 3};
+        inst.visit_all(events);
+        RT_TEST(std::string{"136ab"}, seq);
+
+        inst.visit(std::variant<int, char>{4});
+        RT_TEST(std::string{"136ab10"}, seq);
+
+        auto snap = stats.snapshot();
+        RT_TEST(4u, snap[0].calls);
+        RT_TEST(2u, snap[1].calls);
+    }
+#endif // __cplusplus >= 201703L
+
+    { // value-category preserving keys
+        auto o = overloaded::make_exact(
+             [](const tracked &) { return 1; }
+            ,[](tracked &&t) { tracked sink{std::move(t)}; return 2; }
+        );
+        CT_TEST(true, o.size() == 2);
+        CT_TEST(true, o.exists<int(const tracked &)>());
+        CT_TEST(true, o.exists<int(tracked &&)>());
+
+        tracked t;
+        auto r = o(t);
+        RT_TEST(1, r);
+        RT_TEST(0, tracked::copies);
+        RT_TEST(0, tracked::moves);
+
+        r = o(std::move(t));
+        RT_TEST(2, r);
+        RT_TEST(0, tracked::copies);
+        RT_TEST(1, tracked::moves);
+
+        r = o(tracked{});
+        RT_TEST(2, r);
+        RT_TEST(0, tracked::copies);
+        RT_TEST(2, tracked::moves);
+
+        tracked::moves = 0;
+    }
+    { // value-category preserving keys fall back to the const l-value ref
+        using overloaded_type = overloaded::make_overloaded_exact<
+             int(const tracked &)
+            ,int(int)
+        >::type;
+        overloaded_type o = overloaded::make_exact(
+             [](const tracked &) { return 1; }
+            ,[](int v) { return v; }
+        );
+
+        auto r = o(tracked{});
+        RT_TEST(1, r);
+        r = o(3);
+        RT_TEST(3, r);
+        RT_TEST(0, tracked::copies);
+        RT_TEST(0, tracked::moves);
+    }
+    { // value-category preserving keys are matched per parameter
+        auto o = overloaded::make_exact(
+             [](const std::string &, tracked &&t) { tracked sink{std::move(t)}; return 1; }
+            ,[](const std::string &, const tracked &) { return 2; }
+            ,[](std::string &&, const tracked &) { return 3; }
+        );
+
+        std::string s{"x"};
+        tracked t;
+        auto r = o(std::string{"x"}, t);
+        RT_TEST(3, r);
+        r = o(s, t);
+        RT_TEST(2, r);
+        RT_TEST(0, tracked::copies);
+        RT_TEST(0, tracked::moves);
+
+        r = o(s, std::move(t));
+        RT_TEST(1, r);
+        r = o(s, tracked{});
+        RT_TEST(1, r);
+        RT_TEST(0, tracked::copies);
+        RT_TEST(2, tracked::moves);
+
+        tracked::moves = 0;
+    }
+
+    { // compile-time function pointers
+        using overloaded_type = overloaded::make_overloaded<
+             OVERLOADED_FN(f1)
+            ,OVERLOADED_FN(f2)
+        >::type;
+        CT_TEST(1u, sizeof(overloaded_type));
+
+        overloaded_type o = overloaded::make(OVERLOADED_FN(f1){}, OVERLOADED_FN(f2){});
+        CT_TEST(true, o.exists<void()>());
+        CT_TEST(true, o.exists<int(const int &)>());
+
+        o();
+        RT_TEST(1, f1_counter);
+        auto r = o(4);
+        RT_TEST(8, r);
+        RT_TEST(1, f2_counter);
+        f1_counter = 0;
+        f2_counter = 0;
+    }
+    { // empty holders take no space
+        int v = 3;
+        auto l0 = [](int i) { return i+1; };
+        auto l1 = [](double d) { return d*2; };
+        auto l2 = [v](long l) { return l+v; };
+        auto l3 = [&v](char c) { return c+v; };
+
+        using type0 = overloaded::make_overloaded<decltype(l0), decltype(l1)>::type;
+        CT_TEST(true, std::is_empty<type0>::value);
+        using type1 = overloaded::make_overloaded<decltype(l0), OVERLOADED_FN(f1)>::type;
+        CT_TEST(true, std::is_empty<type1>::value);
+        using type2 = overloaded::make_overloaded<decltype(l0), decltype(l2)>::type;
+        CT_TEST(sizeof(int), sizeof(type2));
+        using type3 = overloaded::make_overloaded<decltype(l0), decltype(l1), decltype(l3)>::type;
+        CT_TEST(sizeof(int *), sizeof(type3));
+        using type4 = overloaded::make_overloaded<
+             decltype(l2)
+            ,decltype(l0)
+            ,decltype(l3)
+            ,decltype(l1)
+        >::type;
+        CT_TEST(sizeof(int *)*2, sizeof(type4));
+
+        type0 o0 = overloaded::make(l0, l1);
+        auto r0 = o0(1);
+        RT_TEST(2, r0);
+        type3 o3 = overloaded::make(l0, l1, l3);
+        auto r1 = o3('a');
+        RT_TEST('a'+3, r1);
+        type4 o4 = overloaded::make(l2, l0, l3, l1);
+        auto r2 = o4(4l);
+        RT_TEST(7, r2);
+    }
+    { // broadcast to several callable-elems with the same signature
+        std::vector<int> log;
+        auto o = overloaded::make_multi(
+             [&log](int v) { log.push_back(v); }
+            ,[&log](const std::string &s) { log.push_back(static_cast<int>(s.size())); }
+            ,[&log](int v) { log.push_back(v*10); }
+            ,[&log](const int &v) { log.push_back(v*100); }
+        );
+        CT_TEST(4u, o.size());
+
+        o.broadcast(1);
+        RT_TEST(3u, log.size());
+        RT_TEST(1, log[0]);
+        RT_TEST(10, log[1]);
+        RT_TEST(100, log[2]);
+
+        o.broadcast(std::string("abcd"));
+        RT_TEST(4u, log.size());
+        RT_TEST(4, log[3]);
+
+        o(std::string("ab"));
+        RT_TEST(5u, log.size());
+        RT_TEST(2, log[4]);
+    }
+    { // broadcast to the same empty functor type twice
+        auto o = overloaded::make_multi(OVERLOADED_FN(f2){}, OVERLOADED_FN(f2){}, OVERLOADED_FN(f1){});
+        o.broadcast(3);
+        RT_TEST(2, f2_counter);
+        RT_TEST(0, f1_counter);
+        o.broadcast();
+        RT_TEST(1, f1_counter);
+        f1_counter = 0;
+        f2_counter = 0;
+    }
+    { // merge of two overload sets
+        auto core = overloaded::make(
+             [](int v) { return v+1; }
+            ,[](const std::string &s) { return s.size(); }
+        );
+        auto proto = overloaded::make([](double v) { return v*2; });
+
+        auto o = overloaded::merge(core, std::move(proto));
+        CT_TEST(3u, o.size());
+        CT_TEST(true, o.exists<int(int)>());
+        CT_TEST(true, o.exists<double(double)>());
+        CT_TEST(true, o.index_of<double(double)>() == 2);
+        CT_TEST(true, std::is_empty<decltype(o)>::value);
+        CT_TEST(true, std::is_same<decltype(o)::policy_type, overloaded::no_policy>::value);
+
+        RT_TEST(3, o(2));
+        RT_TEST(3.0, o(1.5));
+        RT_TEST(2u, o(std::string("ab")));
+    }
+    { // merge moves the holders as is
+        auto n = 0;
+        auto counter = overloaded::make([n](int v) mutable { return n += v; });
+        auto names = overloaded::make([](const std::string &s) { return s.size(); });
+        counter(5);
+
+        auto o = overloaded::merge(counter, names);
+        CT_TEST(true, sizeof(o) == sizeof(int));
+        auto r = o(1);
+        RT_TEST(6, r);
+        r = counter(1);
+        RT_TEST(6, r);
+
+        auto o2 = overloaded::merge(std::move(counter), names);
+        CT_TEST(true, std::is_same<decltype(o)::map_type, decltype(o2)::map_type>::value);
+        r = o2(2);
+        RT_TEST(8, r);
+    }
+    { // merge with the right side overriding
+        auto core = overloaded::make(
+             [](int v) { return v+1; }
+            ,[](const std::string &s) { return s.size(); }
+        );
+        auto test = overloaded::make([](int v) { return v*100; });
+
+        auto o = overloaded::merge_override(core, test);
+        CT_TEST(2u, o.size());
+        CT_TEST(true, o.index_of<std::size_t(std::string)>() == 0);
+        CT_TEST(true, o.index_of<int(int)>() == 1);
+        RT_TEST(200, o(2));
+        RT_TEST(3u, o(std::string("abc")));
+        RT_TEST(3, core(2));
+    }
+    { // extend with callables
+        auto core = overloaded::make([](int v) { return v+1; });
+        auto o = core
+            .extend([](double v) { return v*2; })
+            .extend([](char c) { return c+1; }, [](const std::string &s) { return s.size(); });
+        CT_TEST(4u, o.size());
+        RT_TEST(3, o(2));
+        RT_TEST(3.0, o(1.5));
+        RT_TEST('b', o('a'));
+        RT_TEST(1u, o(std::string("a")));
+
+        auto o2 = o.extend_override([](int v) { return -v; });
+        CT_TEST(4u, o2.size());
+        RT_TEST(-2, o2(2));
+        RT_TEST(3.0, o2(1.5));
+    }
+    { // best viable callable-elem
+        auto o = overloaded::make(
+             [](std::int64_t v) { return v*2; }
+            ,[](const std::string &s) { return s.size(); }
+        );
+        CT_TEST(false, o.exists<std::int64_t(int)>());
+
+        auto r0 = o.invoke_best(21);
+        RT_TEST(42, r0);
+        auto r2 = o.invoke_best("abc");
+        RT_TEST(3u, r2);
+        std::int64_t v = 4;
+        auto r3 = o.invoke_best(v);
+        RT_TEST(8, r3);
+    }
+    { // best viable callable-elem, the exact match wins and the ambiguities are detected
+        auto o = overloaded::make(
+             [](int v) { return v+1; }
+            ,[](long v) { return v+2; }
+            ,[](double v) { return v+3; }
+        );
+        auto r0 = o.invoke_best(1);
+        RT_TEST(2, r0);
+        auto r1 = o.invoke_best(1l);
+        RT_TEST(3, r1);
+        auto r2 = o.invoke_best(1.0f);
+        RT_TEST(4.0, r2);
+
+        using map_type = decltype(o)::map_type;
+        using best0 = overloaded::details::best_viable<map_type, short &&>;
+        CT_TEST(true, best0::found && best0::value == 0);
+        using best1 = overloaded::details::best_viable<map_type, unsigned &&>;
+        CT_TEST(true, !best1::found && best1::ambiguous);
+        using best2 = overloaded::details::best_viable<map_type, std::string &&>;
+        CT_TEST(true, !best2::found && !best2::ambiguous);
+    }
+    { // best viable mutable callable-elem
+        auto n = 0l;
+        auto o = overloaded::make([n](long v) mutable { return n += v; });
+        o.invoke_best(2);
+        auto r = o.invoke_best('\x03');
+        RT_TEST(5, r);
+    }
+    { // hot-swappable callable-elem
+        auto o = overloaded::make(
+             overloaded::hot_swappable<int(int)>([](int v) { return v+1; })
+            ,[](const std::string &s) { return s.size(); }
+        );
+        CT_TEST(true, o.exists<int(int)>());
+
+        auto r0 = o(1);
+        RT_TEST(2, r0);
+        o.get<int(int)>().store([](int v) { return v*10; });
+        auto r1 = o(2);
+        RT_TEST(20, r1);
+        o.get<int(int)>().reclaim();
+        auto r2 = o(3);
+        RT_TEST(30, r2);
+    }
+    { // hot-swappable callable-elem, re-armed after the move
+        overloaded::hot_swappable<int(int)> slot([](int v) { return v+1; });
+        overloaded::hot_swappable<int(int)> moved{std::move(slot)};
+        slot.store([](int v) { return v+2; });
+        auto r = slot(1);
+        RT_TEST(3, r);
+        r = moved(1);
+        RT_TEST(2, r);
+    }
+    { // hot-swappable callable-elem, stress
+        enum { readers = 4, stores = 2000 };
+
+        overloaded::hot_swappable<int(int)> slot([](int v) { return v; });
+        auto o = overloaded::make(slot);
+
+        std::atomic<bool> stop{false};
+        std::atomic<int> errors{0};
+        std::vector<std::thread> threads;
+        for ( int i = 0; i < readers; ++i ) {
+            threads.emplace_back([&] {
+                int last = 0;
+                while ( !stop.load(std::memory_order_relaxed) ) {
+                    // the generation of the callable can only grow
+                    int gen = o(0);
+                    if ( gen < last || gen > stores ) {
+                        errors.fetch_add(1);
+                    }
+                    last = gen;
+                }
+            });
+        }
+        for ( int gen = 1; gen <= stores; ++gen ) {
+            slot.store([gen](int v) { return v+gen; });
+        }
+        stop = true;
+        for ( auto &t: threads ) {
+            t.join();
+        }
+        slot.reclaim();
+
+        RT_TEST(0, errors.load());
+        auto r = o(1);
+        RT_TEST(stores+1, r);
+    }
+    { // async dispatcher
+        std::vector<int> ints;
+        std::vector<std::string> strings;
+        auto o = overloaded::make(
+             [&ints](int v) { ints.push_back(v); }
+            ,[&strings](std::string s) { strings.push_back(std::move(s)); }
+        );
+        {
+            overloaded::async_dispatcher<decltype(o)> d(o, 4);
+            RT_TEST(2u, d.workers());
+
+            for ( int i = 0; i < 100; ++i ) {
+                d.post(i);
+            }
+            d.post(std::string("a"));
+            d.post(std::string("b"));
+            d.stop();
+        }
+        RT_TEST(100u, ints.size());
+        RT_TEST(true, std::is_sorted(ints.begin(), ints.end()));
+        RT_TEST(2u, strings.size());
+        RT_TEST("b", strings[1]);
+    }
+    { // async dispatcher, many producers
+        enum { producers = 4, posts = 1000 };
+
+        std::atomic<long> sum{0};
+        long local = 0;
+        auto o = overloaded::make(
+             [&sum](int v) { sum.fetch_add(v); }
+            ,[&local](long v) { local += v; }
+        );
+        overloaded::async_dispatcher<decltype(o), 16> d(o, 2);
+
+        std::vector<std::thread> threads;
+        for ( int p = 0; p < producers; ++p ) {
+            threads.emplace_back([&d] {
+                for ( int i = 1; i <= posts; ++i ) {
+                    d.post(i);
+                    d.post(static_cast<long>(i));
+                }
+            });
+        }
+        for ( auto &t: threads ) {
+            t.join();
+        }
+        d.stop();
+
+        RT_TEST(producers*posts*(posts+1)/2, sum.load());
+        RT_TEST(producers*posts*(posts+1)/2, local);
+    }
+    { // async dispatcher, the workers sharing the ring of a single callable-elem
+        enum { posts = 1000 };
+
+        std::atomic<long> sum{0};
+        auto o = overloaded::make([&sum](int v) { sum.fetch_add(v); });
+        overloaded::async_dispatcher<decltype(o), 16> d(o, 3, overloaded::async_mode::shared);
+        RT_TEST(3u, d.workers());
+
+        for ( int i = 1; i <= posts; ++i ) {
+            d.post(i);
+        }
+        d.stop();
+        RT_TEST(posts*(posts+1)/2, sum.load());
+
+        auto r0 = d.post(1);
+        RT_TEST(false, r0);
+        auto r1 = d.try_post(1);
+        RT_TEST(false, r1);
+    }
+    { // async dispatcher, the full ring
+        std::atomic<bool> entered{false};
+        std::atomic<bool> gate{false};
+        auto o = overloaded::make([&](int) {
+            entered = true;
+            while ( !gate ) { std::this_thread::yield(); }
+        });
+        overloaded::async_dispatcher<decltype(o), 2> d(o);
+
+        d.post(1);
+        while ( !entered ) { std::this_thread::yield(); }
+        auto r0 = d.try_post(2);
+        RT_TEST(true, r0);
+        auto r1 = d.try_post(3);
+        RT_TEST(false, r1);
+        gate = true;
+    }
+    { // call counters and latency histograms
+        CT_TEST(true, std::is_empty<
+            overloaded::make_overloaded<
+                 OVERLOADED_FN(f1)
+                ,OVERLOADED_FN(f2)
+            >::with_policy<overloaded::no_policy>
+        >::value);
+
+        auto o = overloaded::make(
+             [](int v) { return v; }
+            ,[](double) {}
+        );
+        overloaded::call_stats stats{o};
+        RT_TEST(2u, stats.size());
+        CT_TEST(false, std::is_default_constructible<overloaded::instrumented>::value);
+        auto inst = overloaded::with_policy(o, overloaded::instrumented{&stats});
+
+        for ( int i = 0; i < 10; ++i ) {
+            inst(i);
+        }
+        std::thread([&inst] { inst(1); inst(0.5); }).join();
+
+        auto snap = stats.snapshot();
+        RT_TEST(2u, snap.size());
+        RT_TEST(11u, snap[0].calls);
+        RT_TEST(1u, snap[1].calls);
+        RT_TEST(true, snap[0].percentile_ns(50) <= snap[0].percentile_ns(99));
+
+        // a bucket is within 12.5% of the value
+        bool precise = true;
+        for ( std::uint64_t v: {0ull, 7ull, 8ull, 9ull, 100ull, 1000ull, 123456789ull, ~0ull} ) {
+            std::uint64_t limit = overloaded::details::latency_bucket_limit(
+                overloaded::details::latency_bucket(v)
+            );
+            precise = precise && limit >= v && limit - v <= v / 8;
+        }
+        RT_TEST(true, precise);
+    }
+    { // call counters of the batch, broadcast and by-index calls
+        struct negate {};
+        auto o = overloaded::make(
+             [](int v) { return v; }
+            ,[](negate, int v) { return -v; }
+        );
+        overloaded::call_stats stats{o};
+        auto inst = overloaded::with_policy(o, overloaded::instrumented{&stats});
+
+        const int values[] = {1, 2, 3};
+        int results[3] = {};
+        inst.invoke_each(values, results);
+        RT_TEST(3, results[2]);
+        inst.broadcast(1);
+        auto r = inst.invoke_by_index(1, 4);
+        RT_TEST(-4, r);
+
+        auto snap = stats.snapshot();
+        RT_TEST(4u, snap[0].calls);
+        RT_TEST(1u, snap[1].calls);
+    }
+    { // double dispatch
+        auto o = overloaded::make(
+             [](const shape &, const shape &) { return 0; }
+            ,[](const circle &, const circle &) { return 1; }
+            ,[](const circle &, const box &) { return 2; }
+            ,[](const box &, const shape &) { return 3; }
+        );
+        circle c;
+        box b;
+        triangle t;
+        const shape &sc = c, &sb = b, &st = t;
+
+        auto r = o.dispatch<shapes>(sc, sc);
+        RT_TEST(1, r);
+        r = o.dispatch<shapes>(sc, sb);
+        RT_TEST(2, r);
+        r = o.dispatch<shapes>(sb, sc);
+        RT_TEST(3, r);
+        r = o.dispatch<shapes>(sb, sb);
+        RT_TEST(3, r);
+        r = o.dispatch<shapes>(st, sc);
+        RT_TEST(0, r);
+        r = o.dispatch<shapes>(sc, st);
+        RT_TEST(0, r);
+    }
+    { // double dispatch, the mutable callable-elem, the missing pairs and the unknown ids
+        auto n = 0;
+        auto o = overloaded::make(
+             [n](circle &, box &) mutable { return ++n; }
+            ,[](box &, circle &) { return -1; }
+        );
+        circle c;
+        box b;
+        shape &sc = c, &sb = b;
+
+        o.dispatch<shapes>(sc, sb);
+        auto r = o.dispatch<shapes>(sc, sb);
+        RT_TEST(2, r);
+        r = o.dispatch<shapes>(sb, sc);
+        RT_TEST(-1, r);
+
+        bool thrown = false;
+        try { o.dispatch<shapes>(sc, sc); } catch (const std::invalid_argument &) { thrown = true; }
+        RT_TEST(true, thrown);
+
+        shape unknown{7};
+        thrown = false;
+        try { o.dispatch<shapes>(unknown, sc); } catch (const std::out_of_range &) { thrown = true; }
+        RT_TEST(true, thrown);
+    }
+    { // runtime-typed overload set
+        overloaded::dynamic_overloaded d;
+        int calls = 0;
+        d.add([&calls](int v) { calls++; return v*2; })
+         .add([](const std::string &s) { return s.size(); })
+         .add([&calls](double, int) { calls++; });
+        RT_TEST(3u, d.size());
+
+        // not sealed yet
+        bool thrown = false;
+        try { d.call<int>(1); } catch (const std::out_of_range &) { thrown = true; }
+        RT_TEST(true, thrown);
+
+        d.seal();
+        RT_TEST(true, d.sealed());
+        RT_TEST(true, d.exists<int(int)>());
+        RT_TEST(false, d.exists<long(int)>());
+        RT_TEST(false, d.exists<int(char)>());
+
+        auto r0 = d.call<int>(3);
+        RT_TEST(6, r0);
+        auto r1 = d.call<std::size_t>(std::string("abc"));
+        RT_TEST(3u, r1);
+        d.call(0.5, 1);
+        RT_TEST(2, calls);
+
+        // the result type is a part of the signature
+        thrown = false;
+        try { d.call<long>(3); } catch (const std::out_of_range &) { thrown = true; }
+        RT_TEST(true, thrown);
+
+        thrown = false;
+        try { d.add([](char) {}); } catch (const std::logic_error &) { thrown = true; }
+        RT_TEST(true, thrown);
+
+        // the moved-from object is empty and open for the registration
+        overloaded::dynamic_overloaded moved{std::move(d)};
+        auto r2 = moved.call<int>(4);
+        RT_TEST(8, r2);
+        RT_TEST(false, d.sealed());
+        RT_TEST(false, d.exists<int(int)>());
+        thrown = false;
+        try { d.call<int>(3); } catch (const std::out_of_range &) { thrown = true; }
+        RT_TEST(true, thrown);
+
+        d.add([](int v) { return v+1; }).seal();
+        auto r3 = d.call<int>(3);
+        RT_TEST(4, r3);
+        moved = std::move(d);
+        r3 = moved.call<int>(3);
+        RT_TEST(4, r3);
+        RT_TEST(0u, d.size());
+    }
+    { // runtime-typed overload set, the duplicates and the perfect hash of many signatures
+        overloaded::dynamic_overloaded d;
+        d.add([](int v) { return v; });
+
+        bool thrown = false;
+        try { d.add([](const int &v) { return v+1; }); } catch (const std::invalid_argument &) { thrown = true; }
+        RT_TEST(true, thrown);
+
+        register_plugin_msgs(d, std::integral_constant<int, 40>{});
+        d.seal();
+        RT_TEST(41u, d.size());
+        RT_TEST(true, d.table_size() >= 2*d.size() && d.table_size() < 4*d.size());
+
+        auto r0 = d.call<int>(plugin_msg<1>{10});
+        RT_TEST(11, r0);
+        auto r1 = d.call<int>(plugin_msg<40>{10});
+        RT_TEST(50, r1);
+        auto r2 = d.call<int>(plugin_msg<17>{0});
+        RT_TEST(17, r2);
+
+        // the colliding hashes don't make the types equal
+        const std::string name = typeid(int(int)).name();
+        const auto &id = overloaded::details::stable_type_id<int(int)>();
+        RT_TEST(true, (id == overloaded::details::stable_type{id.hash, name.c_str()}));
+        RT_TEST(false, (id == overloaded::details::stable_type{id.hash, "collision"}));
+    }
+#if __cplusplus >= 201703L
+    { // binary call frames
+        std::vector<std::string> log;
+        long isum = 0;
+        double dsum = 0;
+        auto o = overloaded::make(
+             [&](int a, double b) { isum += a; dsum += b; }
+            ,[&](std::string_view s, long n) { log.emplace_back(s); isum += n; }
+            ,[&](const char *s) { log.emplace_back(s); }
+        );
+
+        std::vector<std::byte> buf;
+        overloaded::wire_encode<void(int, double)>(o, buf, 3, 0.5);
+        overloaded::wire_encode<void(std::string_view, long)>(o, buf, std::string("abc"), 4);
+        overloaded::wire_encode<void(const char *)>(o, buf, "xyz");
+
+        // the explicit and the narrowing conversions don't compile
+        CT_TEST(true, (overloaded::details::is_wire_convertible<std::string_view, std::string &&>::value));
+        CT_TEST(true, (overloaded::details::is_wire_convertible<long, int &&>::value));
+        CT_TEST(false, (overloaded::details::is_wire_convertible<const char *, long &&>::value));
+        CT_TEST(false, (overloaded::details::is_wire_convertible<int, double &&>::value));
+        CT_TEST(false, (overloaded::details::is_wire_convertible<std::vector<int>, std::size_t &&>::value));
+
+        std::size_t pos = 0;
+        std::size_t frames = 0;
+        while ( std::size_t n = overloaded::dispatch_from(o, buf.data() + pos, buf.size() - pos) ) {
+            pos += n;
+            ++frames;
+        }
+        RT_TEST(3u, frames);
+        RT_TEST(buf.size(), pos);
+        RT_TEST(7, isum);
+        RT_TEST(0.5, dsum);
+        RT_TEST(2u, log.size());
+        RT_TEST("abc", log[0]);
+        RT_TEST("xyz", log[1]);
+
+        // the truncated frame and the unknown slot index
+        auto r0 = overloaded::dispatch_from(o, buf.data(), 8);
+        RT_TEST(0u, r0);
+        std::vector<std::byte> bad(4, std::byte{0xff});
+        auto r1 = overloaded::dispatch_from(o, bad.data(), bad.size());
+        RT_TEST(0u, r1);
+        RT_TEST(7, isum);
+    }
+    { // recording the calls
+        long sum = 0;
+        std::vector<std::string> names;
+        auto o = overloaded::make(
+             [&](int v) { sum += v; }
+            ,[&](std::string_view s) { names.emplace_back(s); }
+        );
+
+        std::vector<std::string> paths;
+        {
+            // four slots, so the first call is overwritten
+            overloaded::call_log log{"overloaded-test-recording", 4};
+            auto rec = overloaded::with_policy(o, overloaded::recording{&log});
+            log.attach();
+            RT_TEST(1u, log.paths().size());
+
+            rec(1);
+            rec(std::string_view("a"));
+            rec(2);
+            rec(3);
+            rec(4);
+            std::thread([&rec] { rec(100); }).join();
+
+            paths = log.paths();
+        }
+        RT_TEST(2u, paths.size());
+        RT_TEST(110, sum);
+
+        sum = 0;
+        names.clear();
+        auto n = overloaded::replay(paths, o);
+        RT_TEST(5u, n);
+        RT_TEST(109, sum);
+        RT_TEST(1u, names.size());
+        RT_TEST("a", names[0]);
+
+        for ( const auto &path: paths ) {
+            std::remove(path.c_str());
+        }
+    }
+    { // recording of the calls, the invalid geometry
+        CT_TEST(false, std::is_default_constructible<overloaded::recording>::value);
+
+        bool thrown = false;
+        try { overloaded::call_log log{"overloaded-test-recording", 0}; } catch (const std::invalid_argument &) { thrown = true; }
+        RT_TEST(true, thrown);
+        thrown = false;
+        try { overloaded::call_log log{"overloaded-test-recording", 4, 0}; } catch (const std::invalid_argument &) { thrown = true; }
+        RT_TEST(true, thrown);
+
+        auto o = overloaded::make([](int) {});
+        std::string path;
+        {
+            overloaded::call_log log{"overloaded-test-recording", 4};
+            overloaded::with_policy(o, overloaded::recording{&log})(1);
+            path = log.paths().at(0);
+        }
+
+        // the header of the slot size below the record header, and of the overflowing ring size
+        const std::uint64_t headers[][2] = {{8, 4}, {std::uint64_t(1) << 32, std::uint64_t(1) << 32}};
+        for ( const auto &h: headers ) {
+            std::FILE *f = std::fopen(path.c_str(), "r+b");
+            std::fseek(f, sizeof(std::uint64_t), SEEK_SET);
+            std::fwrite(h, sizeof(h), 1, f);
+            std::fclose(f);
+
+            thrown = false;
+            try { overloaded::replay(path, o); } catch (const std::runtime_error &) { thrown = true; }
+            RT_TEST(true, thrown);
+        }
+        std::remove(path.c_str());
+    }
+#endif // __cplusplus >= 201703L
+#if defined(__cpp_lib_span)
+    { // binary call frames, spans
+        double sum = 0;
+        auto o = overloaded::make(
+             [&](char) {}
+            ,[&](std::span<const double> v) { for ( double d: v ) sum += d; }
+        );
+        const double values[] = {1.0, 2.0, 4.0};
+
+        std::vector<std::byte> buf;
+        overloaded::wire_encode<void(char)>(o, buf, 'a');
+        overloaded::wire_encode<void(std::span<const double>)>(o, buf, std::span<const double>{values});
+
+        std::size_t n0 = overloaded::dispatch_from(o, buf.data(), buf.size());
+        std::size_t n1 = overloaded::dispatch_from(o, buf.data() + n0, buf.size() - n0);
+        RT_TEST(buf.size(), n0 + n1);
+        RT_TEST(7.0, sum);
+    }
+#endif // __cpp_lib_span
+#if __cplusplus >= 202002L
+    { // awaitable overload sets
+        auto o = overloaded::make(
+             [](int v) -> task<int> { co_return v*2; }
+            ,[](const std::string &s) { return static_cast<int>(s.size()); }
+        );
+        auto outer = [&o]() -> task<int> {
+            int a = co_await overloaded::co_invoke(o, 4);
+            int b = co_await overloaded::co_invoke(o, std::string("abc"));
+            co_return a+b;
+        };
+
+        auto r0 = outer().get();
+        RT_TEST(11, r0);
+        std::size_t cached = overloaded::frame_pool::cached();
+        RT_TEST(true, cached != 0);
+
+        // the frames are reused
+        auto r1 = outer().get();
+        RT_TEST(11, r1);
+        RT_TEST(cached, overloaded::frame_pool::cached());
+    }
+#endif // __cplusplus >= 202002L
+#if __cplusplus >= 201703L
+    { // best viable callable-elem, no argument temporaries
+        const char *data = nullptr;
+        auto o = overloaded::make([&data](std::string_view s) { data = s.data(); return s.size(); });
+
+        std::string str("abcd");
+        auto r = o.invoke_best(str);
+        RT_TEST(4u, r);
+        RT_TEST(true, data == str.data());
+    }
+    { // compile-time function pointers, C++17 form
+        using overloaded_type = overloaded::make_overloaded<
+             overloaded::fn<&f1>
+            ,overloaded::fn<&f4>
+        >::type;
+        CT_TEST(1u, sizeof(overloaded_type));
+
+        overloaded_type o = overloaded::make(overloaded::fn<&f1>{}, overloaded::fn<&f4>{});
+        auto r = o(1);
+        RT_TEST(3, r);
+        RT_TEST(1, f4_counter);
+        f4_counter = 0;
+    }
+#endif // __cplusplus >= 201703L
+    { // bound member functions
+        accumulator acc;
+        auto add = OVERLOADED_BIND_MEMBER(acc, &accumulator::add);
+        auto get = overloaded::bind_member<decltype(&accumulator::get), &accumulator::get>(acc);
+        using add_holder_type = overloaded::details::callable_holder<decltype(add)>::type;
+        CT_TEST(true, std::is_same<add_holder_type, decltype(add)>::value);
+        CT_TEST(true, sizeof(add) == sizeof(void *));
+
+        auto o = overloaded::make(add, get);
+        CT_TEST(true, o.exists<int(int)>());
+        CT_TEST(true, o.exists<int()>());
+
+        o(2);
+        auto r = o(3);
+        RT_TEST(5, r);
+        r = o();
+        RT_TEST(5, r);
+        RT_TEST(5, acc.sum);
+    }
+    { // bound member functions, the pointer is stored at run time
+        accumulator acc;
+        auto o = overloaded::make(
+             overloaded::bind_member(acc, &accumulator::add)
+            ,overloaded::bind_member(acc, &accumulator::get)
+        );
+
+        o(4);
+        auto r = o();
+        RT_TEST(4, r);
+    }
+#if __cplusplus >= 201703L
+    { // bound member functions, C++17 form
+        accumulator acc;
+        using overloaded_type = overloaded::make_overloaded<
+            overloaded::bound_member<decltype(&accumulator::add), &accumulator::add>
+        >::type;
+        overloaded_type o = overloaded::make(overloaded::bind_member<&accumulator::add>(acc));
+
+        auto r = o(7);
+        RT_TEST(7, r);
+    }
+#endif // __cplusplus >= 201703L
+
     // example of how to create and pass an overloaded object into non-template class/functions
     {
         using overloaded_type = overloaded::make_overloaded<
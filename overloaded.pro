@@ -2,6 +2,7 @@ TEMPLATE = app
 CONFIG += console
 CONFIG -= app_bundle
 CONFIG -= qt
+CONFIG += thread
 
 QMAKE_CXXFLAGS += \
     -std=c++11